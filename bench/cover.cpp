@@ -0,0 +1,427 @@
+// Vertex cover benchmark: solves a fixed suite of generated graphs with every encoding, search strategy
+// and solver backend, each run in its own process, and writes one CSV row per graph and configuration
+// with the median and p99 time, the solver calls, the clauses encoded, the peak memory and the cover
+// size. Given a baseline written by an earlier run, it reports the rows that got worse and exits with 1.
+//
+//    cover-bench [-runs=N] [-out=FILE] [-baseline=FILE] [-tolerance=F] [-filter=TEXT] [solver options]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "minisat/utils/Options.h"
+#include "minisat/utils/System.h"
+
+#include "../encoder.h"
+#include "../heuristics.h"
+#include "../bounds.h"
+#include "../portfolio.h"
+#include "generators.h"
+
+static Minisat::IntOption    opt_runs     ("BENCH", "runs",      "Runs of every graph and configuration.", 5, Minisat::IntRange(1, 1000));
+static Minisat::StringOption opt_out      ("BENCH", "out",       "Write the CSV to this file instead of the standard output.");
+static Minisat::StringOption opt_baseline ("BENCH", "baseline",  "Compare against the CSV of an earlier run and fail on regressions.");
+static Minisat::DoubleOption opt_tolerance("BENCH", "tolerance", "Relative increase of time and memory tolerated by the baseline comparison.", 0.5, Minisat::DoubleRange(0, true, HUGE_VAL, false));
+static Minisat::StringOption opt_filter   ("BENCH", "filter",    "Only run the rows whose key (graph,n,density,encoding,strategy,backend) contains this text.");
+
+struct Suite_Graph
+{
+   const char *generator;
+   int n;
+   double density;
+   uint32_t seed;
+   bool large;          // too large for the slot encoding
+};
+
+// Small graphs are solved with every encoding, large ones with the vertex and native encodings only,
+// as the slot encoding takes minutes to prove their lower bound.
+static const Suite_Graph suite[] = {
+   {"erdos-renyi",     12, 0.3,  1, false},
+   {"barabasi-albert", 12, 0.3,  2, false},
+   {"grid",            12, 0.5,  3, false},
+   {"geometric",       12, 0.4,  4, false},
+   {"bipartite",       12, 0.4,  5, false},
+   {"planted",         12, 0.4,  6, false},
+   {"erdos-renyi",     50, 0.1,  7, true},
+   {"barabasi-albert", 60, 0.1,  8, true},
+   {"grid",            36, 0.5,  9, true},
+   {"geometric",       40, 0.1, 10, true},
+   {"bipartite",       50, 0.15, 11, true},
+   {"planted",         60, 0.2, 12, true},
+};
+
+struct Strategy
+{
+   const char *name;
+   bool hint;           // seed the solver with the greedy cover (-hint)
+   bool bounds;         // search between the lower bound and the greedy cover (-bounds)
+};
+
+static const Strategy strategies[] = {
+   {"linear",      false, false},
+   {"bounds",      false, true},
+   {"hint",        true,  false},
+   {"hint-bounds", true,  true},
+};
+
+struct Backend
+{
+   const char *name;
+   bool simp;           // SimpSolver instead of Solver (-simp)
+   int workers;         // solvers racing on each CNF (-portfolio)
+};
+
+static const Backend backends[] = {
+   {"core",      false, 1},
+   {"simp",      true,  1},
+   {"portfolio", false, 2},
+};
+
+static const Encoding encodings[] = {SLOT_ENCODING, VERTEX_ENCODING, NATIVE_ENCODING};
+static const char *encoding_names[] = {"slot", "vertex", "native"};
+
+// What one run sends back to the benchmark process.
+struct Run_Result
+{
+   double seconds = 0;
+   int solver_calls = 0;
+   int clauses = 0;     // encoded, before any simplification, summed over the CNFs
+   double peak_mb = 0;
+   int cover = -1;
+   bool valid = false;  // the cover covers every edge
+};
+
+template<class Solver>
+static void new_portfolio(std::vector<std::unique_ptr<Solver>> &solvers, std::unique_ptr<Minisat::ClauseExchange> &exchange,
+                          int workers)
+{
+   solvers.clear();
+   for (int i = 0; i < workers; i++){
+      solvers.emplace_back(new Solver());
+      diversify(*solvers.back(), i);
+   }
+   if (workers > 1){
+      exchange.reset(new Minisat::ClauseExchange(workers));
+      share_clauses(solvers, *exchange);
+   }
+}
+
+// The search of the ece650-a4 driver (Input_Parser::create_cnf and search_cover) for one graph.
+template<class Solver>
+static std::vector<int> search_cover(const Bench_Graph &graph, Encoding encoding, const Strategy &strategy, int workers,
+                                     Run_Result &result)
+{
+   int n = graph.n;
+   const std::vector<std::vector<int>> &edge_vector = graph.edge_vector;
+   std::vector<int> hint_cover;
+   if (strategy.hint || strategy.bounds){
+      hint_cover = greedy_cover(n, edge_vector);
+   }
+   int lower = strategy.bounds ? cover_lower_bound(n, edge_vector) : 0;
+   if (strategy.bounds && (int)hint_cover.size() == lower){
+      return hint_cover;
+   }
+
+   std::vector<std::unique_ptr<Solver>> solvers;
+   std::unique_ptr<Minisat::ClauseExchange> exchange;
+   Minisat::vec<Minisat::Lit> literal_set;
+   std::vector<int> cover;
+   int winner = 0;
+
+   if (encoding == NATIVE_ENCODING){
+      int k = strategy.hint || strategy.bounds ? hint_cover.size() : n;
+      new_portfolio(solvers, exchange, workers);
+      for (auto &solver : solvers){
+         encode(*solver, literal_set, encoding, n, k, edge_vector);
+         if (strategy.hint){
+            hint_solver(*solver, literal_set, encoding, n, k, edge_vector, hint_cover);
+         }
+      }
+      result.clauses += solvers[0]->nClauses();
+
+      while (result.solver_calls++, solve_portfolio(solvers, winner)){
+         cover = decode(*solvers[winner], literal_set, encoding, n, k);
+         k = cover.size() - 1;
+         bool tightened = k >= lower;
+         for (unsigned i = 0; i < solvers.size() && tightened; i++){
+            tightened = solvers[i]->setAtMostBound(0, k);
+         }
+         if (!tightened){
+            break;
+         }
+      }
+   }
+   else{
+      for (int k = std::max(lower, 1); k <= n; k++){
+         new_portfolio(solvers, exchange, workers);
+         for (auto &solver : solvers){
+            encode(*solver, literal_set, encoding, n, k, edge_vector);
+            if (strategy.hint){
+               hint_solver(*solver, literal_set, encoding, n, k, edge_vector, hint_cover);
+            }
+         }
+         result.clauses += solvers[0]->nClauses();
+
+         result.solver_calls++;
+         if (solve_portfolio(solvers, winner)){
+            cover = decode(*solvers[winner], literal_set, encoding, n, k);
+            break;
+         }
+      }
+   }
+   return cover;
+}
+
+static bool is_cover(const Bench_Graph &graph, const std::vector<int> &cover)
+{
+   std::vector<bool> in_cover(graph.n, false);
+   for (int v : cover){
+      in_cover[v] = true;
+   }
+   for (unsigned i = 0; i < graph.edge_vector[0].size(); i++){
+      if (!in_cover[graph.edge_vector[0][i]] && !in_cover[graph.edge_vector[1][i]]){
+         return false;
+      }
+   }
+   return true;
+}
+
+// Solves the graph in a child process, so that its peak memory is that of this run alone.
+static bool run(const Bench_Graph &graph, Encoding encoding, const Strategy &strategy, const Backend &backend,
+                Run_Result &result)
+{
+   int fds[2];
+   if (pipe(fds) != 0){
+      return false;
+   }
+   pid_t pid = fork();
+   if (pid < 0){
+      close(fds[0]);
+      close(fds[1]);
+      return false;
+   }
+   if (pid == 0){
+      close(fds[0]);
+      Run_Result r;
+      auto start = std::chrono::steady_clock::now();
+      std::vector<int> cover = backend.simp
+         ? search_cover<Minisat::SimpSolver>(graph, encoding, strategy, backend.workers, r)
+         : search_cover<Minisat::Solver>(graph, encoding, strategy, backend.workers, r);
+      r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      r.peak_mb = Minisat::memUsedPeak();
+      r.cover = cover.size();
+      r.valid = !cover.empty() && is_cover(graph, cover);
+      bool written = write(fds[1], &r, sizeof(r)) == (ssize_t)sizeof(r);
+      close(fds[1]);
+      _exit(written ? 0 : 1);
+   }
+   close(fds[1]);
+   ssize_t got = read(fds[0], &result, sizeof(result));
+   close(fds[0]);
+   int status = 0;
+   waitpid(pid, &status, 0);
+   return got == (ssize_t)sizeof(result) && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+struct Row
+{
+   std::string key;     // graph,n,density,encoding,strategy,backend
+   int runs = 0;
+   double median_ms = 0;
+   double p99_ms = 0;
+   int solver_calls = 0;
+   int clauses = 0;
+   double peak_mb = 0;
+   int cover = -1;
+};
+
+static const char *csv_header = "graph,n,density,encoding,strategy,backend,runs,median_ms,p99_ms,solver_calls,clauses,peak_mb,cover";
+
+static std::string format_row(const Row &row)
+{
+   char buffer[256];
+   snprintf(buffer, sizeof(buffer), "%s,%d,%.3f,%.3f,%d,%d,%.1f,%d", row.key.c_str(), row.runs, row.median_ms,
+            row.p99_ms, row.solver_calls, row.clauses, row.peak_mb, row.cover);
+   return buffer;
+}
+
+// Reads a CSV written by format_row(), keyed by the first six columns.
+static bool read_rows(const char *file, std::map<std::string, Row> &rows)
+{
+   std::ifstream in(file);
+   if (!in){
+      return false;
+   }
+   std::string line;
+   std::getline(in, line);
+   while (std::getline(in, line)){
+      std::vector<std::string> fields;
+      std::stringstream ss(line);
+      std::string field;
+      while (std::getline(ss, field, ',')){
+         fields.push_back(field);
+      }
+      if (fields.size() != 13){
+         continue;
+      }
+      Row row;
+      row.key = fields[0];
+      for (int i = 1; i < 6; i++){
+         row.key += "," + fields[i];
+      }
+      row.runs = atoi(fields[6].c_str());
+      row.median_ms = atof(fields[7].c_str());
+      row.p99_ms = atof(fields[8].c_str());
+      row.solver_calls = atoi(fields[9].c_str());
+      row.clauses = atoi(fields[10].c_str());
+      row.peak_mb = atof(fields[11].c_str());
+      row.cover = atoi(fields[12].c_str());
+      rows[row.key] = row;
+   }
+   return true;
+}
+
+// Prints what got worse in row compared to base. Times below a millisecond are noise. The solvers of
+// a portfolio race for the CPU, so which one answers, how long it takes and how many thread arenas
+// the allocator has reserved by then all vary: its rows get four times the tolerance, counts included.
+static bool regressed(const Row &row, const Row &base, bool racing, double tolerance)
+{
+   bool worse = false;
+   double count_tolerance = 0;
+   if (racing){
+      tolerance *= 4;
+      count_tolerance = tolerance;
+   }
+   if (row.cover != base.cover){
+      fprintf(stderr, "%s: cover %d, baseline %d\n", row.key.c_str(), row.cover, base.cover);
+      worse = true;
+   }
+   if (row.median_ms > base.median_ms * (1 + tolerance) && row.median_ms - base.median_ms > 1){
+      fprintf(stderr, "%s: median %.3f ms, baseline %.3f ms\n", row.key.c_str(), row.median_ms, base.median_ms);
+      worse = true;
+   }
+   if (row.solver_calls > base.solver_calls * (1 + count_tolerance)){
+      fprintf(stderr, "%s: %d solver calls, baseline %d\n", row.key.c_str(), row.solver_calls, base.solver_calls);
+      worse = true;
+   }
+   if (row.clauses > base.clauses * (1 + count_tolerance)){
+      fprintf(stderr, "%s: %d clauses, baseline %d\n", row.key.c_str(), row.clauses, base.clauses);
+      worse = true;
+   }
+   if (row.peak_mb > base.peak_mb * (1 + tolerance)){
+      fprintf(stderr, "%s: peak %.1f MB, baseline %.1f MB\n", row.key.c_str(), row.peak_mb, base.peak_mb);
+      worse = true;
+   }
+   return worse;
+}
+
+int main(int argc, char **argv)
+{
+   Minisat::setUsageHelp("USAGE: %s [options]\n");
+   Minisat::parseOptions(argc, argv, true);
+
+   std::map<std::string, Row> baseline;
+   if ((const char*)opt_baseline != nullptr && !read_rows(opt_baseline, baseline)){
+      fprintf(stderr, "Error: Cannot read %s\n", (const char*)opt_baseline);
+      return 1;
+   }
+   std::ofstream out_file;
+   if ((const char*)opt_out != nullptr){
+      out_file.open((const char*)opt_out);
+      if (!out_file){
+         fprintf(stderr, "Error: Cannot open %s\n", (const char*)opt_out);
+         return 1;
+      }
+   }
+   std::ostream &out = out_file.is_open() ? out_file : std::cout;
+   out << csv_header << "\n";
+
+   int runs = opt_runs;
+   int rows = 0, regressions = 0, missing = 0, failures = 0;
+   for (const Suite_Graph &s : suite){
+      Bench_Graph graph;
+      generate(s.generator, s.n, s.density, s.seed, graph);
+      int graph_cover = -1;
+      for (int e = 0; e < 3; e++){
+         if (s.large && encodings[e] == SLOT_ENCODING){
+            continue;
+         }
+         for (const Strategy &strategy : strategies){
+            for (const Backend &backend : backends){
+               char key[256];
+               snprintf(key, sizeof(key), "%s,%d,%.2f,%s,%s,%s", graph.name.c_str(), graph.n, graph.density,
+                        encoding_names[e], strategy.name, backend.name);
+               if ((const char*)opt_filter != nullptr && strstr(key, opt_filter) == nullptr){
+                  continue;
+               }
+
+               Row row;
+               row.key = key;
+               row.runs = runs;
+               std::vector<double> ms;
+               for (int r = 0; r < runs; r++){
+                  Run_Result result;
+                  if (!run(graph, encodings[e], strategy, backend, result) || !result.valid){
+                     fprintf(stderr, "%s: no vertex cover found\n", key);
+                     failures++;
+                     break;
+                  }
+                  ms.push_back(result.seconds * 1000);
+                  row.solver_calls = std::max(row.solver_calls, result.solver_calls);
+                  row.clauses = std::max(row.clauses, result.clauses);
+                  row.peak_mb = std::max(row.peak_mb, result.peak_mb);
+                  row.cover = result.cover;
+               }
+               if ((int)ms.size() < runs){
+                  continue;
+               }
+               // every configuration finds a minimum cover, so they must all agree on its size
+               if (graph_cover >= 0 && row.cover != graph_cover){
+                  fprintf(stderr, "%s: cover %d, other configurations %d\n", key, row.cover, graph_cover);
+                  failures++;
+               }
+               graph_cover = row.cover;
+
+               std::sort(ms.begin(), ms.end());
+               row.median_ms = runs % 2 ? ms[runs / 2] : (ms[runs / 2 - 1] + ms[runs / 2]) / 2;
+               row.p99_ms = ms[(int)std::ceil(0.99 * runs) - 1];
+               out << format_row(row) << "\n";
+               out.flush();
+               rows++;
+
+               if (!baseline.empty()){
+                  auto base = baseline.find(row.key);
+                  if (base == baseline.end()){
+                     missing++;
+                  }
+                  else if (regressed(row, base->second, backend.workers > 1, opt_tolerance)){
+                     regressions++;
+                  }
+               }
+            }
+         }
+      }
+   }
+
+   fprintf(stderr, "%d rows", rows);
+   if (!baseline.empty()){
+      fprintf(stderr, ", %d regressions, %d not in the baseline", regressions, missing);
+   }
+   if (failures > 0){
+      fprintf(stderr, ", %d failures", failures);
+   }
+   fprintf(stderr, "\n");
+   return regressions > 0 || failures > 0 ? 1 : 0;
+}
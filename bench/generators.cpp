@@ -0,0 +1,186 @@
+#include "generators.h"
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <utility>
+
+// Collects the edges of a graph once each, smaller end first, and hands them out sorted.
+class Edge_Set
+{
+public:
+   void add(int v1, int v2)
+   {
+      if (v1 != v2){
+         edges.insert(std::make_pair(std::min(v1, v2), std::max(v1, v2)));
+      }
+   }
+
+   Bench_Graph graph(const std::string &name, int n, double density) const
+   {
+      Bench_Graph g;
+      g.name = name;
+      g.n = n;
+      g.density = density;
+      g.edge_vector.resize(2);
+      for (auto &e : edges){
+         g.edge_vector[0].push_back(e.first);
+         g.edge_vector[1].push_back(e.second);
+      }
+      return g;
+   }
+
+private:
+   std::set<std::pair<int, int>> edges;
+};
+
+Bench_Graph erdos_renyi(int n, double density, uint32_t seed)
+{
+   Bench_Random random(seed);
+   Edge_Set edges;
+   for (int v1 = 0; v1 < n; v1++){
+      for (int v2 = v1 + 1; v2 < n; v2++){
+         if (random.real() < density){
+            edges.add(v1, v2);
+         }
+      }
+   }
+   return edges.graph("erdos-renyi", n, density);
+}
+
+Bench_Graph barabasi_albert(int n, double density, uint32_t seed)
+{
+   Bench_Random random(seed);
+   Edge_Set edges;
+   int m = std::max(1, (int)std::lround(density * (n - 1) / 2));
+   // every vertex appears once per edge end, so a uniform pick is a pick proportional to degree
+   std::vector<int> ends;
+   for (int v = 1; v < n; v++){
+      if (ends.empty()){
+         edges.add(v, 0);
+         ends.push_back(0);
+         ends.push_back(v);
+         continue;
+      }
+      std::set<int> targets;
+      for (int attempt = 0; (int)targets.size() < std::min(m, v) && attempt < 16 * m; attempt++){
+         targets.insert(ends[random.below(ends.size())]);
+      }
+      for (int t : targets){
+         edges.add(v, t);
+         ends.push_back(t);
+         ends.push_back(v);
+      }
+   }
+   return edges.graph("barabasi-albert", n, density);
+}
+
+Bench_Graph grid(int n, double density, uint32_t seed)
+{
+   Bench_Random random(seed);
+   Edge_Set edges;
+   int columns = std::max(1, (int)std::ceil(std::sqrt((double)n)));
+   for (int v = 0; v < n; v++){
+      bool right = (v + 1) % columns != 0 && v + 1 < n;
+      bool down = v + columns < n;
+      if (right){
+         edges.add(v, v + 1);
+      }
+      if (down){
+         edges.add(v, v + columns);
+      }
+      if (right && down && random.real() < density){
+         edges.add(v, v + columns + 1);
+      }
+   }
+   return edges.graph("grid", n, density);
+}
+
+Bench_Graph random_geometric(int n, double density, uint32_t seed)
+{
+   Bench_Random random(seed);
+   Edge_Set edges;
+   std::vector<double> x(n), y(n);
+   for (int v = 0; v < n; v++){
+      x[v] = random.real();
+      y[v] = random.real();
+   }
+   double radius2 = density / 3.14159265358979323846;
+   for (int v1 = 0; v1 < n; v1++){
+      for (int v2 = v1 + 1; v2 < n; v2++){
+         double dx = x[v1] - x[v2];
+         double dy = y[v1] - y[v2];
+         if (dx * dx + dy * dy < radius2){
+            edges.add(v1, v2);
+         }
+      }
+   }
+   return edges.graph("geometric", n, density);
+}
+
+Bench_Graph bipartite(int n, double density, uint32_t seed)
+{
+   Bench_Random random(seed);
+   Edge_Set edges;
+   int half = n / 2;
+   for (int v1 = 0; v1 < half; v1++){
+      for (int v2 = half; v2 < n; v2++){
+         if (random.real() < density){
+            edges.add(v1, v2);
+         }
+      }
+   }
+   return edges.graph("bipartite", n, density);
+}
+
+Bench_Graph planted_cover(int n, double density, uint32_t seed)
+{
+   Bench_Random random(seed);
+   Edge_Set edges;
+   // a random n / 3 vertices form the cover, so that it does not show in the vertex numbers
+   std::vector<int> order(n);
+   for (int v = 0; v < n; v++){
+      order[v] = v;
+   }
+   for (int v = n - 1; v > 0; v--){
+      std::swap(order[v], order[random.below(v + 1)]);
+   }
+   std::vector<bool> in_cover(n, false);
+   for (int i = 0; i < n / 3; i++){
+      in_cover[order[i]] = true;
+   }
+   for (int v1 = 0; v1 < n; v1++){
+      for (int v2 = v1 + 1; v2 < n; v2++){
+         if ((in_cover[v1] || in_cover[v2]) && random.real() < density){
+            edges.add(v1, v2);
+         }
+      }
+   }
+   return edges.graph("planted", n, density);
+}
+
+bool generate(const std::string &name, int n, double density, uint32_t seed, Bench_Graph &graph)
+{
+   if (name == "erdos-renyi"){
+      graph = erdos_renyi(n, density, seed);
+   }
+   else if (name == "barabasi-albert"){
+      graph = barabasi_albert(n, density, seed);
+   }
+   else if (name == "grid"){
+      graph = grid(n, density, seed);
+   }
+   else if (name == "geometric"){
+      graph = random_geometric(n, density, seed);
+   }
+   else if (name == "bipartite"){
+      graph = bipartite(n, density, seed);
+   }
+   else if (name == "planted"){
+      graph = planted_cover(n, density, seed);
+   }
+   else{
+      return false;
+   }
+   return true;
+}
@@ -0,0 +1,68 @@
+#ifndef GENERATORS_H
+#define GENERATORS_H
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+// Deterministic random graphs for the benchmarks, as the parallel edge vectors kept by Input_Parser
+// (edge_vector[0][i] -- edge_vector[1][i]). The same name, n, density and seed give the same graph on
+// every platform: only the raw std::mt19937 sequence is used, never the library distributions.
+
+struct Bench_Graph
+{
+   std::string name;
+   int n = 0;
+   double density = 0;
+   std::vector<std::vector<int>> edge_vector;
+};
+
+class Bench_Random
+{
+public:
+   explicit Bench_Random(uint32_t seed) : engine(seed) {}
+
+   // uniform in [0, 1)
+   double real()
+   {
+      return engine() / 4294967296.0;
+   }
+
+   // uniform in [0, n)
+   int below(int n)
+   {
+      return (int)(real() * n);
+   }
+
+private:
+   std::mt19937 engine;
+};
+
+// Every pair is an edge with probability density.
+Bench_Graph erdos_renyi(int n, double density, uint32_t seed);
+
+// Preferential attachment: every new vertex gets density * (n - 1) / 2 edges (at least one) to
+// existing vertices chosen in proportion to their degree, as in a graph of the given density.
+Bench_Graph barabasi_albert(int n, double density, uint32_t seed);
+
+// A grid of ceil(sqrt(n)) columns with its horizontal and vertical edges; each cell also gets a
+// diagonal with probability density.
+Bench_Graph grid(int n, double density, uint32_t seed);
+
+// Points in the unit square joined when closer than sqrt(density / pi), which gives an expected
+// degree of about density * (n - 1) away from the borders.
+Bench_Graph random_geometric(int n, double density, uint32_t seed);
+
+// Two halves of n / 2 vertices, every pair across them an edge with probability density.
+Bench_Graph bipartite(int n, double density, uint32_t seed);
+
+// A hidden set of n / 3 vertices covers every edge: each pair with an end in the set is an edge
+// with probability density, so the minimum cover has at most n / 3 vertices.
+Bench_Graph planted_cover(int n, double density, uint32_t seed);
+
+// The generator of the given name ("erdos-renyi", "barabasi-albert", "grid", "geometric",
+// "bipartite" or "planted"). Returns false if it is unknown.
+bool generate(const std::string &name, int n, double density, uint32_t seed, Bench_Graph &graph);
+
+#endif
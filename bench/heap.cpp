@@ -0,0 +1,86 @@
+// Variable order heap microbenchmark: replays the solver's use of the heap (activity bumps followed
+// by decrease(), and decisions popped with removeMin() then reinserted on backtracking) on a large
+// number of variables, for binary, 4-ary and 8-ary heaps.
+//
+//    heap-bench [variables] [operations]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "minisat/mtl/Heap.h"
+
+struct Activity_Lt
+{
+   const std::vector<double> &activity;
+   bool operator()(int x, int y) const
+   {
+      return activity[x] > activity[y];
+   }
+};
+
+template<int D>
+static void run(int variables, int operations)
+{
+   std::vector<double> activity(variables);
+   std::mt19937 random(91648253);
+   std::uniform_real_distribution<double> initial(0, 0.00001);
+   for (auto &a : activity){
+      a = initial(random);
+   }
+   Minisat::Heap<int, Activity_Lt, Minisat::MkIndexDefault<int>, D> heap(Activity_Lt{activity});
+   for (int v = 0; v < variables; v++){
+      heap.insert(v);
+   }
+
+   // bumps: VSIDS raises the activity of a few hundred variables per conflict by a growing amount
+   std::uniform_int_distribution<int> pick(0, variables - 1);
+   double increment = 1;
+   std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+   for (int i = 0; i < operations; i++){
+      int v = pick(random);
+      if ((activity[v] += increment) > 1e100){
+         for (auto &a : activity){
+            a *= 1e-100;
+         }
+         increment *= 1e-100;
+      }
+      heap.decrease(v);
+      increment *= 1 / 0.95;
+   }
+   double bump_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+   // decisions: pop a trail's worth of variables, then put them back as the solver backtracks
+   std::vector<int> trail;
+   long long checksum = 0;
+   int removed = 0;
+   start = std::chrono::steady_clock::now();
+   while (removed < operations){
+      for (int i = 0; i < 1000 && !heap.empty(); i++){
+         trail.push_back(heap.removeMin());
+         checksum += trail.back();
+      }
+      removed += trail.size();
+      for (auto v : trail){
+         heap.insert(v);
+      }
+      trail.clear();
+   }
+   double pop_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+   printf("%5d  %14.2f  %20.2f  %lld\n", D, operations / bump_seconds / 1e6, removed / pop_seconds / 1e6, checksum);
+}
+
+int main(int argc, char **argv)
+{
+   int variables = argc > 1 ? atoi(argv[1]) : 1000000;
+   int operations = argc > 2 ? atoi(argv[2]) : 5000000;
+
+   printf("arity  decrease Mop/s  removeMin+insert Mop/s  checksum\n");
+   run<2>(variables, operations);
+   run<4>(variables, operations);
+   run<8>(variables, operations);
+   return 0;
+}
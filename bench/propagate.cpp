@@ -0,0 +1,150 @@
+// Propagation microbenchmark: solves a DIMACS file under a conflict budget once per prefetch distance
+// and reports the propagation rate and, where the kernel exposes the hardware counters, the cache
+// misses per thousand propagations. MiniSat options are accepted as well, e.g. -clause-align.
+//
+//    propagate-bench [-clause-align] [-huge-pages] file.cnf [conflicts]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <zlib.h>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "minisat/core/Dimacs.h"
+#include "minisat/core/Solver.h"
+#include "minisat/utils/Options.h"
+
+// A hardware event counted for this thread only, or nothing if the kernel refuses it.
+class Perf_Counter
+{
+public:
+   Perf_Counter(uint32_t type, uint64_t config)
+   {
+#if defined(__linux__)
+      struct perf_event_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.type = type;
+      attr.size = sizeof(attr);
+      attr.config = config;
+      attr.disabled = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+      (void)type;
+      (void)config;
+#endif
+   }
+
+   ~Perf_Counter()
+   {
+#if defined(__linux__)
+      if (fd >= 0){
+         close(fd);
+      }
+#endif
+   }
+
+   bool available() const
+   {
+      return fd >= 0;
+   }
+
+   void start()
+   {
+#if defined(__linux__)
+      if (fd >= 0){
+         ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+         ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+#endif
+   }
+
+   uint64_t stop()
+   {
+      uint64_t count = 0;
+#if defined(__linux__)
+      if (fd >= 0){
+         ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+         if (read(fd, &count, sizeof(count)) != sizeof(count)){
+            count = 0;
+         }
+      }
+#endif
+      return count;
+   }
+
+private:
+   int fd = -1;
+};
+
+int main(int argc, char **argv)
+{
+   Minisat::setUsageHelp("USAGE: %s [options] <input-file> [conflicts]\n");
+   Minisat::parseOptions(argc, argv, true);
+   if (argc < 2){
+      fprintf(stderr, "USAGE: %s [options] <input-file> [conflicts]\n", argv[0]);
+      return 1;
+   }
+   int64_t conflicts = argc > 2 ? atoll(argv[2]) : 20000;
+
+#if defined(__linux__)
+   Perf_Counter cache_misses(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+   Perf_Counter l1_misses(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+#else
+   Perf_Counter cache_misses(0, 0);
+   Perf_Counter l1_misses(0, 0);
+#endif
+   if (!cache_misses.available()){
+      fprintf(stderr, "Hardware cache counters are not available, only the propagation rate is reported\n");
+   }
+
+   printf("prefetch  propagations      seconds    props/sec  LLC miss/kprop  L1D miss/kprop\n");
+   int distances[] = {0, 2, 4, 8, 16};
+   for (auto distance : distances){
+      Minisat::Solver solver;
+      solver.prefetch_dist = distance;
+      gzFile in = gzopen(argv[1], "rb");
+      if (in == NULL){
+         fprintf(stderr, "Error: could not open %s\n", argv[1]);
+         return 1;
+      }
+      Minisat::parse_DIMACS(in, solver);
+      gzclose(in);
+
+      solver.setConfBudget(conflicts);
+      Minisat::vec<Minisat::Lit> assumptions;
+      cache_misses.start();
+      l1_misses.start();
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      solver.solveLimited(assumptions);
+      double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      uint64_t llc = cache_misses.stop();
+      uint64_t l1 = l1_misses.stop();
+
+      double kprops = solver.propagations / 1000.0;
+      printf("%8d  %12llu  %11.3f  %11.0f", distance, (unsigned long long)solver.propagations, seconds, solver.propagations / seconds);
+      if (cache_misses.available()){
+         printf("  %14.1f", llc / kprops);
+      }
+      else{
+         printf("  %14s", "n/a");
+      }
+      if (l1_misses.available()){
+         printf("  %14.1f\n", l1 / kprops);
+      }
+      else{
+         printf("  %14s\n", "n/a");
+      }
+   }
+   return 0;
+}
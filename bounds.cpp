@@ -0,0 +1,292 @@
+#include "bounds.h"
+
+#include <algorithm>
+#include <queue>
+
+#include "heuristics.h"
+
+// Edmonds' blossom algorithm: grows alternating trees from a free vertex and contracts odd cycles
+// (blossoms) into their base until an augmenting path is found.
+class Blossom_Matching
+{
+public:
+   Blossom_Matching(const std::vector<std::vector<int>> &adjacency)
+      : adjacency(adjacency), n(adjacency.size()), match(n, -1), parent(n), base(n), used(n), blossom(n)
+   {
+   }
+
+   int size()
+   {
+      int matched = 0;
+
+      // start from a greedy matching, then augment along alternating paths
+      for (int v = 0; v < n; v++){
+         for (auto u : adjacency[v]){
+            if (match[v] == -1 && match[u] == -1){
+               match[v] = u;
+               match[u] = v;
+               matched++;
+            }
+         }
+      }
+
+      for (int root = 0; root < n; root++){
+         if (match[root] != -1){
+            continue;
+         }
+         int v = find_path(root);
+         if (v == -1){
+            continue;
+         }
+         matched++;
+         while (v != -1){
+            int pv = parent[v];
+            int ppv = match[pv];
+            match[v] = pv;
+            match[pv] = v;
+            v = ppv;
+         }
+      }
+      return matched;
+   }
+
+private:
+   const std::vector<std::vector<int>> &adjacency;
+   int n;
+   std::vector<int> match;
+   std::vector<int> parent;
+   std::vector<int> base;
+   std::vector<bool> used;
+   std::vector<bool> blossom;
+
+   // lowest common ancestor of a and b in the alternating tree (on contracted bases)
+   int lca(int a, int b)
+   {
+      std::vector<bool> on_path(n, false);
+      while (true){
+         a = base[a];
+         on_path[a] = true;
+         if (match[a] == -1){
+            break;
+         }
+         a = parent[match[a]];
+      }
+      while (true){
+         b = base[b];
+         if (on_path[b]){
+            return b;
+         }
+         b = parent[match[b]];
+      }
+   }
+
+   void mark_path(int v, int b, int child)
+   {
+      while (base[v] != b){
+         blossom[base[v]] = true;
+         blossom[base[match[v]]] = true;
+         parent[v] = child;
+         child = match[v];
+         v = parent[match[v]];
+      }
+   }
+
+   // returns the free vertex ending an augmenting path from root, or -1
+   int find_path(int root)
+   {
+      std::fill(used.begin(), used.end(), false);
+      std::fill(parent.begin(), parent.end(), -1);
+      for (int i = 0; i < n; i++){
+         base[i] = i;
+      }
+
+      std::queue<int> queue;
+      used[root] = true;
+      queue.push(root);
+      while (!queue.empty()){
+         int v = queue.front();
+         queue.pop();
+         for (auto to : adjacency[v]){
+            if (base[v] == base[to] || match[v] == to){
+               continue;
+            }
+            if (to == root || (match[to] != -1 && parent[match[to]] != -1)){
+               // odd cycle: contract the blossom into its base
+               int current_base = lca(v, to);
+               std::fill(blossom.begin(), blossom.end(), false);
+               mark_path(v, current_base, to);
+               mark_path(to, current_base, v);
+               for (int i = 0; i < n; i++){
+                  if (blossom[base[i]]){
+                     base[i] = current_base;
+                     if (!used[i]){
+                        used[i] = true;
+                        queue.push(i);
+                     }
+                  }
+               }
+            }
+            else if (parent[to] == -1){
+               parent[to] = v;
+               if (match[to] == -1){
+                  return to;
+               }
+               used[match[to]] = true;
+               queue.push(match[to]);
+            }
+         }
+      }
+      return -1;
+   }
+};
+
+int matching_bound(int n, const std::vector<std::vector<int>> &edge_vector)
+{
+   std::vector<std::vector<int>> adjacency = adjacency_list(n, edge_vector);
+   Blossom_Matching matching(adjacency);
+   return matching.size();
+}
+
+int clique_cover_bound(int n, const std::vector<std::vector<int>> &edge_vector)
+{
+   std::vector<std::vector<int>> adjacency = adjacency_list(n, edge_vector);
+   std::vector<int> order(n);
+   for (int v = 0; v < n; v++){
+      order[v] = v;
+      std::sort(adjacency[v].begin(), adjacency[v].end(), [&adjacency](int a, int b){
+         return adjacency[a].size() > adjacency[b].size();
+      });
+   }
+   std::stable_sort(order.begin(), order.end(), [&adjacency](int a, int b){
+      return adjacency[a].size() > adjacency[b].size();
+   });
+
+   // hits[u] counts the members of the current clique adjacent to u
+   std::vector<bool> assigned(n, false);
+   std::vector<int> hits(n, 0);
+   int cliques = 0;
+
+   for (auto v : order){
+      if (assigned[v]){
+         continue;
+      }
+      assigned[v] = true;
+      cliques++;
+
+      int clique_size = 1;
+      std::vector<int> touched;
+      for (auto u : adjacency[v]){
+         hits[u]++;
+         touched.push_back(u);
+      }
+      for (auto u : adjacency[v]){
+         if (assigned[u] || hits[u] != clique_size){
+            continue;
+         }
+         assigned[u] = true;
+         clique_size++;
+         for (auto w : adjacency[u]){
+            hits[w]++;
+            touched.push_back(w);
+         }
+      }
+      for (auto u : touched){
+         hits[u] = 0;
+      }
+   }
+
+   return n - cliques;
+}
+
+// Hopcroft-Karp on the bipartite double cover: left copy u is adjacent to right copy v for every
+// edge <u,v> (in both directions).
+class Hopcroft_Karp
+{
+public:
+   Hopcroft_Karp(const std::vector<std::vector<int>> &adjacency)
+      : adjacency(adjacency), n(adjacency.size()), match_left(n, -1), match_right(n, -1), distance(n)
+   {
+   }
+
+   int size()
+   {
+      int matched = 0;
+      while (bfs()){
+         for (int u = 0; u < n; u++){
+            if (match_left[u] == -1 && dfs(u)){
+               matched++;
+            }
+         }
+      }
+      return matched;
+   }
+
+private:
+   const std::vector<std::vector<int>> &adjacency;
+   int n;
+   std::vector<int> match_left;
+   std::vector<int> match_right;
+   std::vector<int> distance;
+
+   // layers the left vertices by alternating distance from the free ones; true if a free right
+   // vertex can be reached
+   bool bfs()
+   {
+      std::queue<int> queue;
+      for (int u = 0; u < n; u++){
+         if (match_left[u] == -1){
+            distance[u] = 0;
+            queue.push(u);
+         }
+         else{
+            distance[u] = -1;
+         }
+      }
+
+      bool found = false;
+      while (!queue.empty()){
+         int u = queue.front();
+         queue.pop();
+         for (auto v : adjacency[u]){
+            int w = match_right[v];
+            if (w == -1){
+               found = true;
+            }
+            else if (distance[w] == -1){
+               distance[w] = distance[u] + 1;
+               queue.push(w);
+            }
+         }
+      }
+      return found;
+   }
+
+   bool dfs(int u)
+   {
+      for (auto v : adjacency[u]){
+         int w = match_right[v];
+         if (w == -1 || (distance[w] == distance[u] + 1 && dfs(w))){
+            match_left[u] = v;
+            match_right[v] = u;
+            return true;
+         }
+      }
+      // dead end for this phase
+      distance[u] = -1;
+      return false;
+   }
+};
+
+int lp_bound(int n, const std::vector<std::vector<int>> &edge_vector)
+{
+   std::vector<std::vector<int>> adjacency = adjacency_list(n, edge_vector);
+   Hopcroft_Karp matching(adjacency);
+   return (matching.size() + 1) / 2;
+}
+
+int cover_lower_bound(int n, const std::vector<std::vector<int>> &edge_vector)
+{
+   // a matching is a feasible solution of the dual of the LP relaxation, so lp_bound() is never
+   // below matching_bound() and the blossom algorithm does not need to run here
+   return std::max(lp_bound(n, edge_vector), clique_cover_bound(n, edge_vector));
+}
@@ -0,0 +1,23 @@
+#ifndef BOUNDS_H
+#define BOUNDS_H
+
+#include <vector>
+
+// Lower bounds on the size of a minimum vertex cover. The graph is given by the parallel edge
+// vectors kept by Input_Parser (edge_vector[0][i] -- edge_vector[1][i]).
+
+// Size of a maximum matching (Edmonds' blossom algorithm): every matched edge needs its own cover vertex.
+int matching_bound(int n, const std::vector<std::vector<int>> &edge_vector);
+
+// Greedy partition of the vertices into cliques: a clique of s vertices needs s - 1 of them in the
+// cover, so the bound is n minus the number of cliques.
+int clique_cover_bound(int n, const std::vector<std::vector<int>> &edge_vector);
+
+// Optimum of the LP relaxation rounded up. The LP optimum is half the size of a maximum matching of
+// the bipartite double cover (u -- v' and v -- u' for every edge), found with Hopcroft-Karp.
+int lp_bound(int n, const std::vector<std::vector<int>> &edge_vector);
+
+// The best of the bounds above.
+int cover_lower_bound(int n, const std::vector<std::vector<int>> &edge_vector);
+
+#endif
@@ -14,6 +14,13 @@
 #include <vector>
 
 #include <chrono>
+#include <fstream>
+
+#include "encoder.h"
+#include "heuristics.h"
+#include "bounds.h"
+#include "portfolio.h"
+#include "stats.h"
 
 
 
@@ -206,8 +213,6 @@ private:
    int n = 0;
    int num_vecs = 2;
    bool found_duplicate_edge = false;
-   bool duplicate_clause_entry_v1 = false;
-   bool duplicate_clause_entry_v2 = false;
 
 
 
@@ -243,6 +248,10 @@ private:
       }
       else
       {
+         auto start = std::chrono::steady_clock::now();
+         stats.clear();
+         stats.vertices = n;
+         std::vector<std::vector<int>> parsed(2);
          std::string edge_set = input.substr(whitespace, input.length()-1);
          char edge_set_rb = '}';
          std::size_t current_pos;
@@ -272,6 +281,18 @@ private:
                flag = 0;
                break;
             }
+            parsed[0].push_back(v1);
+            parsed[1].push_back(v2);
+            edge_set.erase(0,edge_set.find_first_of('>', 0) + 2);
+            flag = 2;
+            current_pos = edge_set.find(edge_set_rb, 0);
+         }
+         stats.parse_seconds = seconds_since(start);
+
+         start = std::chrono::steady_clock::now();
+         for (unsigned e = 0; e < parsed[0].size(); e++){
+            int v1 = parsed[0][e];
+            int v2 = parsed[1][e];
             for (unsigned i = 0; i < edge_vector[0].size(); i++){
                if ((edge_vector[0][i] == v1 && edge_vector[1][i] == v2) || (edge_vector[0][i] == v2 && edge_vector[1][i] == v1)){
                   found_duplicate_edge = true;
@@ -282,193 +303,180 @@ private:
                edge_vector[1].push_back(v2);
             }
             found_duplicate_edge = false;
-            edge_set.erase(0,edge_set.find_first_of('>', 0) + 2);
-            flag = 2;
-            current_pos = edge_set.find(edge_set_rb, 0);
          }
-
+         stats.dedup_seconds = seconds_since(start);
+         stats.edges = edge_vector[0].size();
       }
    }
 
-   void create_cnf(){
-
-      if (flag == 2){
+   // Statistics of the SimpSolver runs of the last create_cnf(), summed over its solvers.
+   void record_simp(const Minisat::Solver &solver, int clauses_before)
+   {
+   }
 
+   void record_simp(const Minisat::SimpSolver &solver, int clauses_before)
+   {
+      simp_vars += solver.nVars();
+      simp_eliminated += solver.eliminated_vars;
+      simp_clauses_before += clauses_before;
+      simp_clauses_after += solver.nClauses();
+   }
 
-         std::unique_ptr<Minisat::Solver> solver(new Minisat::Solver());
+   // A portfolio of 'portfolio' solvers for one problem, sharing their short learnt clauses
+   // through exchange when there is more than one.
+   template<class Solver>
+   void new_portfolio(std::vector<std::unique_ptr<Solver>> &solvers, std::unique_ptr<Minisat::ClauseExchange> &exchange)
+   {
+      solvers.clear();
+      for (int i = 0; i < portfolio; i++){
+         solvers.emplace_back(new Solver());
+         diversify(*solvers.back(), i);
+      }
+      if (portfolio > 1){
+         exchange.reset(new Minisat::ClauseExchange(portfolio, share_buffer, share_size, share_lbd));
+         share_clauses(solvers, *exchange);
+      }
+   }
 
-         Minisat::vec<Minisat::Lit> literal_set;
-         Minisat::vec<Minisat::Lit> clause1;
-         // Minisat::vec<Minisat::Lit> clause2;
-         // Minisat::vec<Minisat::Lit> clause3;
-         Minisat::vec<Minisat::Lit> clause4;
-         auto start = std::chrono::system_clock::now();
+   // solve_portfolio(), recording the time and the counters of the solver that answered in stats.
+   template<class Solver>
+   bool timed_solve(std::vector<std::unique_ptr<Solver>> &solvers, int k, int &winner)
+   {
+      std::vector<Solve_Stats> before;
+      for (auto &solver : solvers){
+         before.push_back(solver_snapshot(*solver));
+      }
+      auto start = std::chrono::steady_clock::now();
+      bool res = solve_portfolio(solvers, winner);
+      stats.add_solve(k, res, seconds_since(start), before[winner], *solvers[winner]);
+      return res;
+   }
 
-         for (int k = 1; k <= n; k++){
-            literal_set.clear();
+   // SAT search for a cover of size at least lower: a fresh portfolio per k, or with the native
+   // encoding a single portfolio that tightens its bound after every cover found.
+   template<class Solver>
+   bool search_cover(int lower, const std::vector<int> &hint_cover, std::vector<int> &vertex_cover_list)
+   {
+      std::vector<std::unique_ptr<Solver>> solvers;
+      std::unique_ptr<Minisat::ClauseExchange> exchange;
+      Minisat::vec<Minisat::Lit> literal_set;
+      bool found = false;
+      int winner = 0;
+
+      if (encoding == NATIVE_ENCODING){
+         // the bound of a native constraint can be tightened between solves, so a single portfolio
+         // walks k down from an upper bound until no smaller cover exists
+         int k = phase_hint || use_bounds ? hint_cover.size() : n;
+         int clauses_before = 0;
+         auto start = std::chrono::steady_clock::now();
+         new_portfolio(solvers, exchange);
+         for (auto &solver : solvers){
+            encode(*solver, literal_set, encoding, n, k, edge_vector);
+            clauses_before = solver->nClauses();
+
+            if (phase_hint){
+               hint_solver(*solver, literal_set, encoding, n, k, edge_vector, hint_cover);
+            }
+         }
+         stats.encode_seconds += seconds_since(start);
 
-            //initialize literal_set
+         while (timed_solve(solvers, k, winner)){
+            vertex_cover_list = decode(*solvers[winner], literal_set, encoding, n, k);
+            found = true;
 
-            for (int i = 0; i < n; i++){
-               for (int j = 0; j < k; j++){
-                  Minisat::Lit literal;
-                  literal = Minisat::mkLit(solver->newVar());
-                  literal_set.push(literal);
-               }
+            k = vertex_cover_list.size() - 1;
+            bool tightened = k >= lower;
+            for (unsigned i = 0; i < solvers.size() && tightened; i++){
+               tightened = solvers[i]->setAtMostBound(0, k);
             }
-
-            //clause 1
-            // for all i element of [1,k], a clause (x[1,i], x[2,i], ... , x[n,i])
-            // std::cout << "Clause 1 ------------------------------" << std::endl;
-            // std::string should_clause1 = "(";
-            // std::string actual_clause1 = "(";
-            for (int i = 1; i <= k; i ++){
-               clause1.clear();
-               for (int r = 1; r <= n; r++){
-                  clause1.push(literal_set[(r - 1)*k + (i - 1) ]);
-                  // should_clause1 += ", x[" + std::to_string(r) + "," + std::to_string(i) + "]";
-                  // actual_clause1 += ", x[" + std::to_string((r - 1)*k + (i - 1)) +"]";
-                  // std::cout << "n = " << n << ", k = " << k << ", r = " << r << ", i = " << i << std::endl;
-               }
-               // std::cout << "Should add to clause 1 - " << should_clause1 << std::endl;
-               // std::cout << "Adding to clause 1 - " << actual_clause1 << std::endl;
-               solver->addClause(clause1);
+            if (!tightened){
+               break;
             }
-            //clause 2
-            // For all m element of [1,n], for all p,q element of [1,k] with p < q
-            // a clause (~x[m,p], ~x[m,q])
-            // std::cout << "Clause 2 ------------------------------" << std::endl;
-            for (int q = 1; q <= k; q++){
-               for (int p = 1; p < q; p++){
-                  for (int m = 1; m <= n; m++){
-                     solver->addClause(~literal_set[(m - 1)*k + (p - 1)],~literal_set[(m - 1)*k + (q - 1)]);
-
-                     // std::cout << "n = " << n << ", k = " << k << ", q = " << q << ", p = " << p << ", m = " << m << std::endl;
-                     // std::cout << "Should add clause (~x[" << m << "," << p <<"], ~x[" << m << "," << q << "])" << std::endl;
-                     // std::cout << "Adding clause (~x[" << (m - 1)*k + (p - 1) << "], ~x[" << (m - 1)*k + (q - 1) << "])" << std::endl;
-                     // std::cout << std::endl;
-                  }
+         }
+         record_simp(*solvers[winner], clauses_before);
+      }
+      else{
+         for (int k = std::max(lower, 1); k <= n; k++){
+            auto start = std::chrono::steady_clock::now();
+            new_portfolio(solvers, exchange);
+            int clauses_before = 0;
+            for (auto &solver : solvers){
+               encode(*solver, literal_set, encoding, n, k, edge_vector);
+               clauses_before = solver->nClauses();
+
+               if (phase_hint){
+                  hint_solver(*solver, literal_set, encoding, n, k, edge_vector, hint_cover);
                }
             }
+            stats.encode_seconds += seconds_since(start);
 
-            //clause 3
-            // For all m element of [1,k], for all p,q element of [1,n] with p < q
-            // a clause (~x[p,m], ~x[q,m])
-            // std::cout << "Clause 3 ------------------------------" << std::endl;
-            for (int m = 1; m <= k; m++){
-               for (int q = 1; q <= n; q++){
-                  for (int p = 1; p < q; p++){
-                     solver->addClause(~literal_set[(p - 1)*k + (m - 1)],~literal_set[(q - 1)*k + (m - 1)]);
-                     // std::cout << "n = " << n << ", k = " << k << ", q = " << q << ", p = " << p << ", m = " << m << std::endl;
-                     // std::cout << "Should add clause (~x[" << p << "," << m <<"], ~x[" << q << "," << m << "])" << std::endl;
-                     // std::cout << "Adding clause (~x[" << (p - 1)*k + (m - 1) << "], ~x[" << (q - 1)*k + (m - 1) << "])" << std::endl;
-                     // std::cout << std::endl;
-                  }
-               }
+            bool res = timed_solve(solvers, k, winner);
+            record_simp(*solvers[winner], clauses_before);
+            if (res){
+               vertex_cover_list = decode(*solvers[winner], literal_set, encoding, n, k);
+               found = true;
+               break;
             }
+         }
+      }
+      return found;
+   }
 
+   void create_cnf(){
 
+      if (flag == 2){
 
-            //clause 4
-            // For all <i,j> element of Edge Set, a clause (x[i,1], x[i,2], ... , x[i,k], x[j,1], x[j,2], ... , x[j,k])
-            // std::cout << "Clause 4 ------------------------------" << std::endl;
-            for (unsigned i = 0; i < edge_vector[0].size(); i++){
-               clause4.clear();
-               // std::string should_clause = "(";
-               // std::string actual_clause = "(";
-               std::vector <int> clause_entry;
-               for (int c = 1; c <= k; c++){
-                  // std::cout << "n = " << n << ", k = " << k << ", i = " << i << ", c = " << c << ", edge = <" << edge_vector[0][i] << "," << edge_vector[1][i] << ">" << std::endl;
-                  //look for duplicate entries
-                  for (auto entry: clause_entry){
-                     if (entry == edge_vector[0][i]*k + (c - 1)){
-                        duplicate_clause_entry_v1 = true;
-                     }
-                     if (entry == edge_vector[1][i]*k + (c - 1)){
-                        duplicate_clause_entry_v2 = true;
-                     }
-                  }
-                  if (!duplicate_clause_entry_v1){
-                     clause4.push(literal_set[edge_vector[0][i]*k + (c - 1)]);
-                     // std::cout << "Should be adding to clause (x[" << edge_vector[0][i] + 1 << "," << c <<"])" << std::endl;
-                     // std::cout << "Adding to clause (x[" << edge_vector[0][i]*k + (c - 1) << "])" << std::endl;
-                     // should_clause += ", x[" + std::to_string(edge_vector[0][i] + 1) + "," + std::to_string(c) + "]";
-                     // actual_clause += ", x[" + std::to_string( edge_vector[0][i]*k + (c - 1)) + "]";
-                  }
-                  if (!duplicate_clause_entry_v2){
-                     clause4.push(literal_set[edge_vector[1][i]*k + (c - 1)]);
-                     // std::cout << "Should be adding to clause (x[" << edge_vector[1][i] + 1 << "," << c << "])" << std::endl;
-                     // should_clause += ", x[" + std::to_string(edge_vector[1][i] + 1) + "," + std::to_string(c) + "]";
-                     // std::cout << "Adding to clause (x[" << edge_vector[1][i]*k + (c - 1) << "])" << std::endl;
-                     // actual_clause += ", x["  +std::to_string( edge_vector[1][i]*k + (c - 1)) + "]";
-                  }
-                  duplicate_clause_entry_v1 = false;
-                  duplicate_clause_entry_v2 = false;
-
-                  // std::cout << "Should be adding to clause (x[" << edge_vector[0][i] + 1 << "," << c <<"], x[" << edge_vector[1][i] + 1 << "," << c << "])" << std::endl;
-                  // should_clause += ", x[" + std::to_string(edge_vector[0][i] + 1) + "," + std::to_string(c) + "], x[" + std::to_string(edge_vector[1][i] + 1) + "," + std::to_string(c) + "]";
-                  // std::cout << "Adding to clause (x[" << edge_vector[0][i]*k + (c - 1) << "], x[" << edge_vector[1][i]*k + (c - 1) << "])" << std::endl;
-                  // actual_clause += ", x[" + std::to_string( edge_vector[0][i]*k + (c - 1)) + "], x[" +std::to_string( edge_vector[1][i]*k + (c - 1)) + "]";
-                  // std::cout << std::endl;
-               }
-
-               // should_clause += ")";
-               // actual_clause += ")";
-               // std::cout<< std::endl;
-               // std::cout << "Clause should be " << should_clause << std::endl;
-               // std::cout << "Adding clause " << actual_clause << std::endl;
+         auto start = std::chrono::steady_clock::now();
 
-               solver->addClause(clause4);
-               // std::cout<< std::endl;
+         // the greedy cover bounds k from above, cover_lower_bound() from below
+         std::vector <int> hint_cover;
+         if (phase_hint || use_bounds){
+            hint_cover = greedy_cover(n, edge_vector);
+         }
+         int lower = use_bounds ? cover_lower_bound(n, edge_vector) : 0;
+         stats.bounds_seconds = seconds_since(start);
 
-            }
+         std::vector <int> vertex_cover_list;
+         bool found = false;
+         simp_vars = simp_eliminated = simp_clauses_before = simp_clauses_after = 0;
 
-            // if (k == 1){
-            //    for (int i = 0; i < edge_vector[0].size(); i++){
-            //       for (int j = 0; j < 2; j++){
-            //          std::cout << edge_vector[j][i] << " ";
-            //       }
-            //       std::cout << std::endl;
-            //    }
-            // }
+         if (use_bounds && (int)hint_cover.size() == lower){
+            // the greedy cover is optimal, no SAT call needed
+            vertex_cover_list = hint_cover;
+            found = true;
+         }
+         else if (use_simp){
+            found = search_cover<Minisat::SimpSolver>(lower, hint_cover, vertex_cover_list);
+         }
+         else{
+            found = search_cover<Minisat::Solver>(lower, hint_cover, vertex_cover_list);
+         }
 
-            bool res = solver->solve();
-            if (res){
-               // std::cout << "Satisfying assignment found for k = " << k << std::endl;
-               std::vector <int> vertex_cover_list;
-
-                  for (int r = 0; r < n; r++) {
-                       for (int c = 0; c < k; c++) {
-                           if (solver->modelValue(literal_set[r*k + c]) == Minisat::l_True) {
-                               vertex_cover_list.push_back(r);
-                           }
-                       }
-                   }
-
-                   std::sort(vertex_cover_list.begin(), vertex_cover_list.end());
-                   for (unsigned x = 0; x < vertex_cover_list.size(); x++){
-                     if (x + 1 != vertex_cover_list.size()){
-                        std::cout << vertex_cover_list[x] << " ";
-                     }
-                     else{
-                        std::cout << vertex_cover_list[x] << std::endl;
-                     }
-
-                   }
-               auto end = std::chrono::system_clock::now();
-               std::chrono::duration<double> diff = end-start;
-               std::clog << "Duration = " << diff.count() << " seconds" << std::endl << std::endl;
+         if (found){
+            auto output_start = std::chrono::steady_clock::now();
+            for (unsigned x = 0; x < vertex_cover_list.size(); x++){
+               if (x + 1 != vertex_cover_list.size()){
+                  std::cout << vertex_cover_list[x] << " ";
+               }
+               else{
+                  std::cout << vertex_cover_list[x] << std::endl;
+               }
 
-               break;
             }
-            // else{
-               // std::cout << "No solution found for k = " << k << std::endl;
-            // }
-
-            solver.reset (new Minisat::Solver());
+            if (use_simp){
+               std::clog << "Eliminated " << simp_eliminated << " of " << simp_vars << " variables, "
+                         << simp_clauses_before << " -> " << simp_clauses_after << " clauses" << std::endl;
+            }
+            stats.output_seconds = seconds_since(output_start);
+            stats.cover = vertex_cover_list.size();
+            std::clog << "Duration = " << seconds_since(start) << " seconds" << std::endl << std::endl;
+         }
+         stats.total_seconds = seconds_since(start);
+         if (stats_out != nullptr){
+            stats.write_json(*stats_out);
+            stats_out->flush();
          }
 
-         // std::cout << "triple for loop is complete\n";
       }
       else{
          std::cerr << "Error: Not enough information provided for graph input\n";
@@ -511,6 +519,20 @@ private:
 
 public:
    std::vector<std::vector<int>> edge_vector;
+   bool phase_hint = false;
+   bool use_bounds = false;
+   bool use_simp = false;
+   int portfolio = 1;
+   int share_lbd = 2;
+   int share_size = 8;
+   int share_buffer = 1 << 16;
+   Encoding encoding = SLOT_ENCODING;
+   int simp_vars = 0;
+   int simp_eliminated = 0;
+   int simp_clauses_before = 0;
+   int simp_clauses_after = 0;
+   Request_Stats stats;                  // of the last request
+   std::ostream *stats_out = nullptr;    // receives stats as a JSON line after every request
 
 
    void cmd_parser(const std::string &input)
@@ -542,13 +564,48 @@ public:
 
 };
 
-int main()
+static Minisat::BoolOption   opt_phase_hint  ("MVC", "hint",         "Seed solver phases and activities from a greedy vertex cover.", false);
+static Minisat::StringOption opt_encoding    ("MVC", "encoding",     "CNF encoding of the cover (slot, vertex, native).", "slot");
+static Minisat::BoolOption   opt_bounds      ("MVC", "bounds",       "Start the search at a lower bound and stop at the greedy cover when they meet.", false);
+static Minisat::BoolOption   opt_simp        ("MVC", "simp",         "Preprocess the CNF with SimpSolver (variable elimination, subsumption).", false);
+static Minisat::IntOption    opt_portfolio   ("MVC", "portfolio",    "Number of diversified solvers racing on each CNF, sharing learnt clauses.", 1, Minisat::IntRange(1, 256));
+static Minisat::IntOption    opt_share_lbd   ("MVC", "share-lbd",    "Largest LBD of the learnt clauses shared by the portfolio.", 2, Minisat::IntRange(1, INT32_MAX));
+static Minisat::IntOption    opt_share_size  ("MVC", "share-size",   "Largest size of the learnt clauses shared by the portfolio.", 8, Minisat::IntRange(1, 1024));
+static Minisat::IntOption    opt_share_buffer("MVC", "share-buffer", "Words in the ring buffer of shared clauses of each solver.", 1 << 16, Minisat::IntRange(16, INT32_MAX));
+static Minisat::StringOption opt_stats       ("MVC", "stats",        "Append the phase timings and solver counters of every request to this file as JSON lines.");
+
+int main(int argc, char** argv)
 {
+   Minisat::setUsageHelp("USAGE: %s [options] < graph-commands\n");
+   Minisat::parseOptions(argc, argv, true);
 
    std::string new_input;
    Input_Parser Parser;
    Parser.edge_vector.push_back(std::vector<int>(0));
    Parser.edge_vector.push_back(std::vector<int>(0));
+   Parser.phase_hint = opt_phase_hint;
+   Parser.use_bounds = opt_bounds;
+   Parser.use_simp = opt_simp;
+   Parser.portfolio = opt_portfolio;
+   Parser.share_lbd = opt_share_lbd;
+   Parser.share_size = opt_share_size;
+   Parser.share_buffer = opt_share_buffer;
+   if (!parse_encoding(opt_encoding, Parser.encoding))
+   {
+      std::cerr << "Error: Unknown encoding " << (const char*)opt_encoding << "\n";
+      return 1;
+   }
+   std::ofstream stats_file;
+   if ((const char*)opt_stats != nullptr)
+   {
+      stats_file.open((const char*)opt_stats, std::ios::app);
+      if (!stats_file)
+      {
+         std::cerr << "Error: Cannot open " << (const char*)opt_stats << "\n";
+         return 1;
+      }
+      Parser.stats_out = &stats_file;
+   }
 
    while (std::getline(std::cin,new_input))
    {
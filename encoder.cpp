@@ -0,0 +1,189 @@
+#include "encoder.h"
+
+#include <algorithm>
+#include <cstring>
+
+bool parse_encoding(const char *name, Encoding &encoding)
+{
+   if (strcmp(name, "slot") == 0){
+      encoding = SLOT_ENCODING;
+   }
+   else if (strcmp(name, "vertex") == 0){
+      encoding = VERTEX_ENCODING;
+   }
+   else if (strcmp(name, "native") == 0){
+      encoding = NATIVE_ENCODING;
+   }
+   else{
+      return false;
+   }
+   return true;
+}
+
+Minisat::Lit cover_literal(const Minisat::vec<Minisat::Lit> &literal_set, Encoding encoding, int k, int v, int slot)
+{
+   return encoding == SLOT_ENCODING ? literal_set[v*k + slot] : literal_set[v];
+}
+
+template<class Solver>
+static void encode_slots(Solver &solver, Minisat::vec<Minisat::Lit> &literal_set,
+                         int n, int k, const std::vector<std::vector<int>> &edge_vector)
+{
+   Minisat::vec<Minisat::Lit> clause;
+
+   for (int i = 0; i < n; i++){
+      for (int j = 0; j < k; j++){
+         literal_set.push(Minisat::mkLit(solver.newVar()));
+      }
+   }
+
+   //clause 1
+   // for all i element of [1,k], a clause (x[1,i], x[2,i], ... , x[n,i])
+   for (int i = 1; i <= k; i ++){
+      clause.clear();
+      for (int r = 1; r <= n; r++){
+         clause.push(literal_set[(r - 1)*k + (i - 1)]);
+      }
+      solver.addClause(clause);
+   }
+
+   //clause 2
+   // For all m element of [1,n], for all p,q element of [1,k] with p < q
+   // a clause (~x[m,p], ~x[m,q])
+   for (int q = 1; q <= k; q++){
+      for (int p = 1; p < q; p++){
+         for (int m = 1; m <= n; m++){
+            solver.addClause(~literal_set[(m - 1)*k + (p - 1)],~literal_set[(m - 1)*k + (q - 1)]);
+         }
+      }
+   }
+
+   //clause 3
+   // For all m element of [1,k], for all p,q element of [1,n] with p < q
+   // a clause (~x[p,m], ~x[q,m])
+   for (int m = 1; m <= k; m++){
+      for (int q = 1; q <= n; q++){
+         for (int p = 1; p < q; p++){
+            solver.addClause(~literal_set[(p - 1)*k + (m - 1)],~literal_set[(q - 1)*k + (m - 1)]);
+         }
+      }
+   }
+
+   //clause 4
+   // For all <i,j> element of Edge Set, a clause (x[i,1], x[i,2], ... , x[i,k], x[j,1], x[j,2], ... , x[j,k])
+   for (unsigned i = 0; i < edge_vector[0].size(); i++){
+      clause.clear();
+      for (int c = 1; c <= k; c++){
+         clause.push(literal_set[edge_vector[0][i]*k + (c - 1)]);
+         clause.push(literal_set[edge_vector[1][i]*k + (c - 1)]);
+      }
+      solver.addClause(clause);
+   }
+}
+
+// Sequential counter (Sinz 2005) for x[0] + ... + x[n-1] <= k. The register s[i][j] is implied
+// whenever at least j+1 of x[0..i] are true.
+template<class Solver>
+static void at_most_k(Solver &solver, const Minisat::vec<Minisat::Lit> &x, int k)
+{
+   int n = x.size();
+   if (k >= n){
+      return;
+   }
+   if (k == 0){
+      for (int i = 0; i < n; i++){
+         solver.addClause(~x[i]);
+      }
+      return;
+   }
+
+   std::vector<Minisat::Lit> s;
+   for (int i = 0; i < (n - 1)*k; i++){
+      s.push_back(Minisat::mkLit(solver.newVar()));
+   }
+
+   solver.addClause(~x[0], s[0]);
+   for (int j = 1; j < k; j++){
+      solver.addClause(~s[j]);
+   }
+   for (int i = 1; i < n - 1; i++){
+      solver.addClause(~x[i], s[i*k]);
+      solver.addClause(~s[(i - 1)*k], s[i*k]);
+      for (int j = 1; j < k; j++){
+         solver.addClause(~x[i], ~s[(i - 1)*k + (j - 1)], s[i*k + j]);
+         solver.addClause(~s[(i - 1)*k + j], s[i*k + j]);
+      }
+      solver.addClause(~x[i], ~s[(i - 1)*k + (k - 1)]);
+   }
+   solver.addClause(~x[n - 1], ~s[(n - 2)*k + (k - 1)]);
+}
+
+template<class Solver>
+static void encode_vertices(Solver &solver, Minisat::vec<Minisat::Lit> &literal_set, Encoding encoding,
+                            int n, int k, const std::vector<std::vector<int>> &edge_vector)
+{
+   for (int i = 0; i < n; i++){
+      literal_set.push(Minisat::mkLit(solver.newVar()));
+   }
+
+   // every edge <i,j> is covered: (x[i], x[j])
+   for (unsigned i = 0; i < edge_vector[0].size(); i++){
+      solver.addClause(literal_set[edge_vector[0][i]], literal_set[edge_vector[1][i]]);
+   }
+
+   if (encoding == NATIVE_ENCODING){
+      solver.addAtMost(literal_set, k);
+   }
+   else{
+      at_most_k(solver, literal_set, k);
+   }
+}
+
+template<class Solver>
+static void encode_cover(Solver &solver, Minisat::vec<Minisat::Lit> &literal_set, Encoding encoding,
+                         int n, int k, const std::vector<std::vector<int>> &edge_vector)
+{
+   literal_set.clear();
+   if (encoding == SLOT_ENCODING){
+      encode_slots(solver, literal_set, n, k, edge_vector);
+   }
+   else{
+      encode_vertices(solver, literal_set, encoding, n, k, edge_vector);
+   }
+}
+
+void encode(Minisat::Solver &solver, Minisat::vec<Minisat::Lit> &literal_set, Encoding encoding,
+            int n, int k, const std::vector<std::vector<int>> &edge_vector)
+{
+   encode_cover(solver, literal_set, encoding, n, k, edge_vector);
+}
+
+void encode(Minisat::SimpSolver &solver, Minisat::vec<Minisat::Lit> &literal_set, Encoding encoding,
+            int n, int k, const std::vector<std::vector<int>> &edge_vector)
+{
+   encode_cover(solver, literal_set, encoding, n, k, edge_vector);
+
+   // the cover variables are read back from the model and may carry phase hints or a native
+   // constraint that is tightened between solves, so only the auxiliary variables are eliminated
+   for (int i = 0; i < literal_set.size(); i++){
+      solver.setFrozen(Minisat::var(literal_set[i]), true);
+   }
+}
+
+std::vector<int> decode(const Minisat::Solver &solver, const Minisat::vec<Minisat::Lit> &literal_set, Encoding encoding,
+                        int n, int k)
+{
+   int slots = encoding == SLOT_ENCODING ? k : 1;
+   std::vector <int> vertex_cover_list;
+
+   for (int r = 0; r < n; r++) {
+      for (int c = 0; c < slots; c++) {
+         if (solver.modelValue(cover_literal(literal_set, encoding, k, r, c)) == Minisat::l_True) {
+            vertex_cover_list.push_back(r);
+         }
+      }
+   }
+
+   std::sort(vertex_cover_list.begin(), vertex_cover_list.end());
+   return vertex_cover_list;
+}
@@ -0,0 +1,44 @@
+#ifndef ENCODER_H
+#define ENCODER_H
+
+#include <vector>
+
+// defines Solver
+#include "minisat/core/Solver.h"
+// defines SimpSolver
+#include "minisat/simp/SimpSolver.h"
+// defines Var and Lit
+#include "minisat/core/SolverTypes.h"
+
+enum Encoding
+{
+   // x[vertex][slot] for every vertex and each of the k cover positions (see encoding.pdf)
+   SLOT_ENCODING,
+   // one variable per vertex, binary edge clauses and a sequential counter for "at most k"
+   VERTEX_ENCODING,
+   // one variable per vertex, binary edge clauses and a native cardinality constraint (constraint 0
+   // of the solver) for "at most k", whose bound can be tightened between solves
+   NATIVE_ENCODING
+};
+
+// Parses the name used on the command line ("slot", "vertex" or "native"). Returns false if it is unknown.
+bool parse_encoding(const char *name, Encoding &encoding);
+
+// Creates the variables and clauses asking for a vertex cover of size k. literal_set receives the
+// cover variables: n*k slot variables stored row-major, or one variable per vertex.
+void encode(Minisat::Solver &solver, Minisat::vec<Minisat::Lit> &literal_set, Encoding encoding,
+            int n, int k, const std::vector<std::vector<int>> &edge_vector);
+
+// Same for a SimpSolver. The cover variables are frozen, so variable elimination only removes
+// auxiliary variables (the counter registers of the vertex encoding).
+void encode(Minisat::SimpSolver &solver, Minisat::vec<Minisat::Lit> &literal_set, Encoding encoding,
+            int n, int k, const std::vector<std::vector<int>> &edge_vector);
+
+// Reads the cover back from the model of a satisfiable call. The result is sorted.
+std::vector<int> decode(const Minisat::Solver &solver, const Minisat::vec<Minisat::Lit> &literal_set, Encoding encoding,
+                        int n, int k);
+
+// Literal of the variable saying that vertex v is in the cover (at position slot for the slot encoding).
+Minisat::Lit cover_literal(const Minisat::vec<Minisat::Lit> &literal_set, Encoding encoding, int k, int v, int slot);
+
+#endif
@@ -0,0 +1,122 @@
+#include "heuristics.h"
+
+#include <algorithm>
+#include <queue>
+#include <utility>
+
+std::vector<std::vector<int>> adjacency_list(int n, const std::vector<std::vector<int>> &edge_vector)
+{
+   std::vector<std::vector<int>> adjacency(n);
+   for (unsigned i = 0; i < edge_vector[0].size(); i++){
+      adjacency[edge_vector[0][i]].push_back(edge_vector[1][i]);
+      adjacency[edge_vector[1][i]].push_back(edge_vector[0][i]);
+   }
+   return adjacency;
+}
+
+std::vector<int> greedy_cover(int n, const std::vector<std::vector<int>> &edge_vector)
+{
+   std::vector<std::vector<int>> adjacency = adjacency_list(n, edge_vector);
+   std::vector<int> residual(n);
+   std::vector<bool> in_cover(n, false);
+   std::vector<int> cover;
+
+   // max-heap on (uncovered degree, -vertex) so ties go to the smallest vertex; stale entries
+   // are skipped when popped
+   std::priority_queue<std::pair<int, int>> queue;
+   for (int v = 0; v < n; v++){
+      residual[v] = adjacency[v].size();
+      if (residual[v] > 0){
+         queue.push(std::make_pair(residual[v], -v));
+      }
+   }
+
+   while (!queue.empty()){
+      int degree = queue.top().first;
+      int v = -queue.top().second;
+      queue.pop();
+      if (in_cover[v] || degree != residual[v]){
+         continue;
+      }
+      in_cover[v] = true;
+      cover.push_back(v);
+      residual[v] = 0;
+      for (auto u : adjacency[v]){
+         if (!in_cover[u] && residual[u] > 0){
+            residual[u]--;
+            if (residual[u] > 0){
+               queue.push(std::make_pair(residual[u], -u));
+            }
+         }
+      }
+   }
+
+   return prune_cover(n, edge_vector, cover);
+}
+
+std::vector<int> prune_cover(int n, const std::vector<std::vector<int>> &edge_vector, const std::vector<int> &cover)
+{
+   std::vector<std::vector<int>> adjacency = adjacency_list(n, edge_vector);
+   std::vector<bool> in_cover(n, false);
+   for (auto v : cover){
+      in_cover[v] = true;
+   }
+
+   std::vector<int> order(cover);
+   std::stable_sort(order.begin(), order.end(), [&adjacency](int a, int b){
+      return adjacency[a].size() < adjacency[b].size();
+   });
+
+   for (auto v : order){
+      bool redundant = true;
+      for (auto u : adjacency[v]){
+         if (!in_cover[u]){
+            redundant = false;
+            break;
+         }
+      }
+      if (redundant){
+         in_cover[v] = false;
+      }
+   }
+
+   std::vector<int> pruned;
+   for (int v = 0; v < n; v++){
+      if (in_cover[v]){
+         pruned.push_back(v);
+      }
+   }
+   return pruned;
+}
+
+void hint_solver(Minisat::Solver &solver, const Minisat::vec<Minisat::Lit> &literal_set, Encoding encoding, int n, int k,
+                 const std::vector<std::vector<int>> &edge_vector, const std::vector<int> &cover)
+{
+   int slots = encoding == SLOT_ENCODING ? k : 1;
+   std::vector<int> degree(n, 0);
+   int max_degree = 1;
+   for (unsigned i = 0; i < edge_vector[0].size(); i++){
+      max_degree = std::max(max_degree, ++degree[edge_vector[0][i]]);
+      max_degree = std::max(max_degree, ++degree[edge_vector[1][i]]);
+   }
+
+   // seeded activities are at most the bump of a single conflict so that learning takes over quickly
+   for (int r = 0; r < n; r++){
+      for (int c = 0; c < slots; c++){
+         Minisat::Var x = Minisat::var(cover_literal(literal_set, encoding, k, r, c));
+         if (degree[r] > 0){
+            solver.bumpActivity(x, (double)degree[r] / max_degree);
+         }
+         solver.suggestPhase(x, false);
+      }
+   }
+
+   for (unsigned i = 0; i < cover.size(); i++){
+      if (encoding != SLOT_ENCODING){
+         solver.suggestPhase(Minisat::var(cover_literal(literal_set, encoding, k, cover[i], 0)), true);
+      }
+      else if ((int)i < k){
+         solver.suggestPhase(Minisat::var(cover_literal(literal_set, encoding, k, cover[i], i)), true);
+      }
+   }
+}
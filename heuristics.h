@@ -0,0 +1,29 @@
+#ifndef HEURISTICS_H
+#define HEURISTICS_H
+
+#include <vector>
+
+// defines Solver
+#include "minisat/core/Solver.h"
+
+#include "encoder.h"
+
+// Builds adjacency lists from the parallel edge vectors kept by Input_Parser
+// (edge_vector[0][i] -- edge_vector[1][i]).
+std::vector<std::vector<int>> adjacency_list(int n, const std::vector<std::vector<int>> &edge_vector);
+
+// Greedy vertex cover: repeatedly takes the vertex covering the most uncovered edges.
+// The result is sorted.
+std::vector<int> greedy_cover(int n, const std::vector<std::vector<int>> &edge_vector);
+
+// Local search step on a cover: drops every vertex whose neighbours are all in the cover,
+// trying low degree vertices first. The result is sorted and still a vertex cover.
+std::vector<int> prune_cover(int n, const std::vector<std::vector<int>> &edge_vector, const std::vector<int> &cover);
+
+// Seeds the solver with a known cover: with the slot encoding the i-th cover vertex is suggested for
+// slot i, with the other encodings every cover vertex is suggested. All variables of a vertex have
+// their activity raised in proportion to the vertex degree.
+void hint_solver(Minisat::Solver &solver, const Minisat::vec<Minisat::Lit> &literal_set, Encoding encoding, int n, int k,
+                 const std::vector<std::vector<int>> &edge_vector, const std::vector<int> &cover);
+
+#endif
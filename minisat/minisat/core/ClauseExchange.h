@@ -0,0 +1,131 @@
+/********************************************************************************[ClauseExchange.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_ClauseExchange_h
+#define Minisat_ClauseExchange_h
+
+#include <atomic>
+
+#include "minisat/mtl/Vec.h"
+#include "minisat/core/SolverTypes.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// ClauseExchange -- learnt clauses shared between solvers working on the same problem:
+//
+// Every worker owns a ring buffer that only it writes, as records '[size, lbd, lits...]'. Readers
+// never block the writer: a reader that has been lapped skips to the newest record, and a record
+// overwritten while it was being read is detected (seqlock style) and dropped. All workers must
+// have created the same variables in the same order.
+
+class ClauseExchange {
+    struct Ring {
+        std::atomic<uint32_t>* words;
+        std::atomic<uint64_t>  head;      // End of the last complete record.
+        std::atomic<uint64_t>  reserved;  // End of the record being written ('head' once it is complete).
+        Ring() : words(NULL), head(0), reserved(0) {}
+        ~Ring() { delete [] words; }
+    };
+
+    int        n_workers;
+    uint64_t   capacity;
+    int        max_size;
+    unsigned   max_lbd;
+    Ring*      rings;
+    uint64_t*  cursors;                   // 'cursors[w * n_workers + v]': how far worker 'w' has read the ring of 'v'.
+
+    // Not copyable:
+    ClauseExchange(const ClauseExchange&);
+    ClauseExchange& operator=(const ClauseExchange&);
+
+ public:
+    // Clauses with at most 'size' literals and an LBD of at most 'lbd' are shared. Each ring holds
+    // 'ring_words' words (at least enough for one record of the largest size).
+    ClauseExchange(int workers, int ring_words = 1 << 16, int size = 8, int lbd = 2) :
+        n_workers(workers), capacity(ring_words < size + 2 ? size + 2 : ring_words), max_size(size), max_lbd(lbd),
+        rings(new Ring[workers]), cursors(new uint64_t[workers * workers]())
+    {
+        for (int i = 0; i < workers; i++)
+            rings[i].words = new std::atomic<uint32_t>[capacity]();
+    }
+
+    ~ClauseExchange() { delete [] rings; delete [] cursors; }
+
+    int  workers () const { return n_workers; }
+    bool accepts (int size, unsigned lbd) const { return size <= max_size && lbd <= max_lbd; }
+
+    // Publish a clause learnt by 'worker'. Only that worker's thread may call this.
+    void push(int worker, const vec<Lit>& c, unsigned lbd)
+    {
+        assert(c.size() <= max_size);
+        Ring&    r = rings[worker];
+        uint64_t h = r.head.load(std::memory_order_relaxed);
+        uint64_t e = h + 2 + c.size();
+        r.reserved.store(e, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        r.words[h % capacity].store(c.size(), std::memory_order_relaxed);
+        r.words[(h + 1) % capacity].store(lbd, std::memory_order_relaxed);
+        for (int i = 0; i < c.size(); i++)
+            r.words[(h + 2 + i) % capacity].store(toInt(c[i]), std::memory_order_relaxed);
+        r.head.store(e, std::memory_order_release);
+    }
+
+    // Call 'f(lits, lbd)' for every clause published by the other workers since the last call by
+    // 'worker'. Returns how often records were skipped because their writer had overtaken the reader.
+    template<class F>
+    uint64_t pull(int worker, F f)
+    {
+        uint64_t overruns = 0;
+        vec<Lit> tmp;
+        for (int v = 0; v < n_workers; v++){
+            if (v == worker) continue;
+            Ring&     r   = rings[v];
+            uint64_t& pos = cursors[worker * n_workers + v];
+            uint64_t  h   = r.head.load(std::memory_order_acquire);
+            if (h - pos > capacity){
+                // Lapped; records can only be found from a record boundary, so skip them all:
+                overruns++;
+                pos = h; }
+
+            while (pos < h){
+                uint32_t size = r.words[pos % capacity].load(std::memory_order_relaxed);
+                uint32_t lbd  = r.words[(pos + 1) % capacity].load(std::memory_order_relaxed);
+                tmp.clear();
+                for (uint32_t i = 0; i < size && (int)i <= max_size; i++)
+                    tmp.push(toLit(r.words[(pos + 2 + i) % capacity].load(std::memory_order_relaxed)));
+
+                // Keep the record only if the writer has not started to overwrite it meanwhile:
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (r.reserved.load(std::memory_order_relaxed) - pos > capacity || (int)size > max_size){
+                    overruns++;
+                    pos = h;
+                    break; }
+
+                f(tmp, lbd);
+                pos += 2 + size;
+            }
+        }
+        return overruns;
+    }
+};
+
+//=================================================================================================
+}
+
+#endif
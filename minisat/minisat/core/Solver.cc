@@ -19,6 +19,9 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 **************************************************************************************************/
 
 #include <math.h>
+#include <chrono>
+#include <thread>
+#include <vector>
 
 #include "minisat/mtl/Alg.h"
 #include "minisat/mtl/Sort.h"
@@ -38,13 +41,31 @@ static DoubleOption  opt_clause_decay      (_cat, "cla-decay",   "The clause act
 static DoubleOption  opt_random_var_freq   (_cat, "rnd-freq",    "The frequency with which the decision heuristic tries to choose a random variable", 0, DoubleRange(0, true, 1, true));
 static DoubleOption  opt_random_seed       (_cat, "rnd-seed",    "Used by the random variable selection",         91648253, DoubleRange(0, false, HUGE_VAL, false));
 static IntOption     opt_ccmin_mode        (_cat, "ccmin-mode",  "Controls conflict clause minimization (0=none, 1=basic, 2=deep)", 2, IntRange(0, 2));
+static IntOption     opt_bin_min           (_cat, "bin-min",     "Strengthen learnt clauses of at most this size with binary clauses (0=off)", 0, IntRange(0, INT32_MAX));
 static IntOption     opt_phase_saving      (_cat, "phase-saving", "Controls the level of phase saving (0=none, 1=limited, 2=full)", 2, IntRange(0, 2));
+static IntOption     opt_chrono            (_cat, "chrono",      "Backtrack one level instead when a backjump would undo at least this many levels (0=off)", 0, IntRange(0, INT32_MAX));
 static BoolOption    opt_rnd_init_act      (_cat, "rnd-init",    "Randomize the initial activity", false);
+static BoolOption    opt_binary_watches    (_cat, "bin-watches", "Propagate binary clauses from separate watcher lists", false);
+static IntOption     opt_branching         (_cat, "branch",      "Decision heuristic (0=VSIDS, 1=VMTF, 2=CHB)", 0, IntRange(0, 2));
 static BoolOption    opt_luby_restart      (_cat, "luby",        "Use the Luby restart sequence", true);
 static IntOption     opt_restart_first     (_cat, "rfirst",      "The base restart interval", 100, IntRange(1, INT32_MAX));
 static DoubleOption  opt_restart_inc       (_cat, "rinc",        "Restart interval increase factor", 2, DoubleRange(1, false, HUGE_VAL, false));
+static BoolOption    opt_dyn_restart       (_cat, "dyn-restart", "Restart when recent conflicts have a high LBD, blocked when the trail is long", false);
+static DoubleOption  opt_restart_k         (_cat, "restart-k",   "Restart when the recent LBD average times this exceeds the global average", 0.8, DoubleRange(0, false, HUGE_VAL, false));
+static DoubleOption  opt_block_r           (_cat, "block-r",     "Block restarts when the trail exceeds this times its recent average", 1.4, DoubleRange(1, true, HUGE_VAL, false));
+static IntOption     opt_lbd_window        (_cat, "lbd-window",  "Number of conflicts in the recent LBD average", 50, IntRange(1, INT32_MAX));
+static IntOption     opt_trail_window      (_cat, "trail-window","Number of conflicts in the recent trail size average", 5000, IntRange(1, INT32_MAX));
+static BoolOption    opt_inprocessing      (_cat, "inprocess",   "Vivify learnt clauses at restarts and remove learnts subsumed by new ones", false);
+static DoubleOption  opt_inprocess_frac    (_cat, "inprocess-frac", "Propagations spent on vivification, as a fraction of those spent searching", 0.02, DoubleRange(0, false, 1, true));
 static DoubleOption  opt_garbage_frac      (_cat, "gc-frac",     "The fraction of wasted memory allowed before a garbage collection is triggered",  0.20, DoubleRange(0, false, HUGE_VAL, false));
+static IntOption     opt_gc_threads        (_cat, "gc-threads",  "Number of threads relocating clauses during garbage collection", 1, IntRange(1, 256));
+static BoolOption    opt_huge_pages        (_cat, "huge-pages",  "Back the clause database by transparent huge pages (Linux)", false);
+static BoolOption    opt_clause_align      (_cat, "clause-align","Keep the header and first two literals of each clause in one cache line", false);
+static IntOption     opt_prefetch_dist     (_cat, "prefetch",    "Prefetch the clause of the watcher this far ahead during propagation (0 = off)", 0, IntRange(0, 64));
 static IntOption     opt_min_learnts_lim   (_cat, "min-learnts", "Minimum learnt clause limit",  0, IntRange(0, INT32_MAX));
+static BoolOption    opt_lbd_tiers         (_cat, "lbd-tiers",   "Keep learnt clauses in core/tier2/local tiers by LBD", false);
+static IntOption     opt_core_lbd          (_cat, "core-lbd",    "Largest LBD of learnt clauses that are never deleted", 2, IntRange(1, INT32_MAX));
+static IntOption     opt_tier2_lbd         (_cat, "tier2-lbd",   "Largest LBD of learnt clauses that are kept while used", 6, IntRange(1, INT32_MAX));
 
 
 //=================================================================================================
@@ -62,13 +83,29 @@ Solver::Solver() :
   , random_seed      (opt_random_seed)
   , luby_restart     (opt_luby_restart)
   , ccmin_mode       (opt_ccmin_mode)
+  , bin_min          (opt_bin_min)
   , phase_saving     (opt_phase_saving)
+  , chrono           (opt_chrono)
   , rnd_pol          (false)
   , rnd_init_act     (opt_rnd_init_act)
+  , binary_watches   (opt_binary_watches)
+  , branching        (opt_branching)
   , garbage_frac     (opt_garbage_frac)
+  , gc_threads       (opt_gc_threads)
+  , prefetch_dist    (opt_prefetch_dist)
   , min_learnts_lim  (opt_min_learnts_lim)
+  , lbd_tiers        (opt_lbd_tiers)
+  , core_lbd         (opt_core_lbd)
+  , tier2_lbd        (opt_tier2_lbd)
   , restart_first    (opt_restart_first)
   , restart_inc      (opt_restart_inc)
+  , dyn_restart      (opt_dyn_restart)
+  , restart_k        (opt_restart_k)
+  , block_r          (opt_block_r)
+  , lbd_window       (opt_lbd_window)
+  , trail_window     (opt_trail_window)
+  , inprocessing     (opt_inprocessing)
+  , inprocess_frac   (opt_inprocess_frac)
 
     // Parameters (the rest):
     //
@@ -78,14 +115,25 @@ Solver::Solver() :
     //
   , learntsize_adjust_start_confl (100)
   , learntsize_adjust_inc         (1.5)
+  , subsume_window                (20)
 
     // Statistics: (formerly in 'SolverStats')
     //
-  , solves(0), starts(0), decisions(0), rnd_decisions(0), propagations(0), conflicts(0)
+  , solves(0), starts(0), decisions(0), rnd_decisions(0), propagations(0), conflicts(0), blocked_restarts(0)
   , dec_vars(0), num_clauses(0), num_learnts(0), clauses_literals(0), learnts_literals(0), max_literals(0), tot_literals(0)
+  , vivified_clauses(0), vivified_literals(0), subsumed_learnts(0)
+  , exported_clauses(0), imported_clauses(0), import_overruns(0)
+  , bin_min_literals(0), chrono_backtracks(0)
+  , gc_runs(0), gc_time(0), gc_max_pause(0)
 
   , watches            (WatcherDeleted(ca))
+  , watches_bin        (WatcherDeleted(ca))
   , order_heap         (VarOrderLt(activity))
+  , vmtf_first         (var_Undef)
+  , vmtf_last          (var_Undef)
+  , vmtf_search        (var_Undef)
+  , vmtf_stamps        (0)
+  , chb_step           (0.4)
   , ok                 (true)
   , cla_inc            (1)
   , var_inc            (1)
@@ -95,13 +143,27 @@ Solver::Solver() :
   , progress_estimate  (0)
   , remove_satisfied   (true)
   , next_var           (0)
+  , ca                 (1024*1024, opt_huge_pages, opt_clause_align)
+  , card_qhead         (0)
+  , card_confl         (CRef_Undef)
+  , lbd_stamp          (0)
+  , sum_lbd            (0)
+  , inprocess_props    (0)
+  , tier_kept          (0)
 
     // Resource constraints:
     //
   , conflict_budget    (-1)
   , propagation_budget (-1)
   , asynch_interrupt   (false)
-{}
+
+  , exchange           (NULL)
+  , exchange_id        (0)
+{
+    card_start.push(0);
+    for (int i = 0; i < gc_buckets; i++)
+        gc_pauses[i] = 0;
+}
 
 
 Solver::~Solver()
@@ -118,8 +180,9 @@ Solver::~Solver()
 //
 Var Solver::newVar(lbool upol, bool dvar)
 {
-    Var v;
-    if (free_vars.size() > 0){
+    Var  v;
+    bool reused = free_vars.size() > 0;
+    if (reused){
         v = free_vars.last();
         free_vars.pop();
     }else
@@ -127,6 +190,8 @@ Var Solver::newVar(lbool upol, bool dvar)
 
     watches  .init(mkLit(v, false));
     watches  .init(mkLit(v, true ));
+    watches_bin.init(mkLit(v, false));
+    watches_bin.init(mkLit(v, true ));
     assigns  .insert(v, l_Undef);
     vardata  .insert(v, mkVarData(CRef_Undef, 0));
     activity .insert(v, rnd_init_act ? drand(random_seed) * 0.00001 : 0);
@@ -134,7 +199,18 @@ Var Solver::newVar(lbool upol, bool dvar)
     polarity .insert(v, true);
     user_pol .insert(v, upol);
     decision .reserve(v);
+    card_occs.reserve(mkLit(v, true));
+    card_reason.insert(v, -1);
+    trail_pos.insert(v, 0);
     trail    .capacity(v+1);
+    if (branching == branch_vmtf){
+        if (!reused){
+            vmtf_prev .insert(v, var_Undef);
+            vmtf_next .insert(v, var_Undef);
+            vmtf_stamp.insert(v, 0); }
+        vmtfEnqueue(v);
+    }else if (branching == branch_chb)
+        chb_last.insert(v, 0);
     setDecisionVar(v, dvar);
     return v;
 }
@@ -181,11 +257,68 @@ bool Solver::addClause_(vec<Lit>& ps)
 }
 
 
+// Cardinality constraints are propagated by counting their true literals, without clauses or
+// auxiliary variables. Reasons for the literals they imply are only built when 'analyze()' asks.
+//
+bool Solver::addAtMost(const vec<Lit>& ps, int k)
+{
+    assert(decisionLevel() == 0);
+    if (!ok || propagate() != CRef_Undef)
+        return ok = false;
+
+    // Remove duplicate literals:
+    ps.copyTo(add_tmp);
+    sort(add_tmp);
+    Lit p; int i, j;
+    for (i = j = 0, p = lit_Undef; i < add_tmp.size(); i++)
+        if (add_tmp[i] != p)
+            add_tmp[j++] = p = add_tmp[i];
+    add_tmp.shrink(i - j);
+
+    // Everything on the trail has been propagated, so all true literals are counted:
+    card_qhead = qhead;
+    int c     = nAtMosts();
+    int count = 0;
+    for (int i = 0; i < add_tmp.size(); i++){
+        card_lits.push(add_tmp[i]);
+        card_occs[add_tmp[i]].push(c);
+        if (value(add_tmp[i]) == l_True)
+            count++;
+    }
+    card_start.push(card_lits.size());
+    card_bound.push(k);
+    card_count.push(count);
+
+    return setAtMostBound(c, k);
+}
+
+
+bool Solver::setAtMostBound(int c, int k)
+{
+    assert(decisionLevel() == 0);
+    assert(k <= card_bound[c]);
+    if (!ok || propagate() != CRef_Undef)
+        return ok = false;
+
+    card_bound[c] = k;
+    if (card_count[c] > k)
+        return ok = false;
+    else if (card_count[c] == k)
+        for (int i = card_start[c]; i < card_start[c+1]; i++)
+            if (value(card_lits[i]) == l_Undef){
+                uncheckedEnqueue(~card_lits[i], CRef_Lazy);
+                card_reason[var(card_lits[i])] = c; }
+
+    return ok = (propagate() == CRef_Undef);
+}
+
+
 void Solver::attachClause(CRef cr){
     const Clause& c = ca[cr];
     assert(c.size() > 1);
-    watches[~c[0]].push(Watcher(cr, c[1]));
-    watches[~c[1]].push(Watcher(cr, c[0]));
+    OccLists<Lit, vec<Watcher>, WatcherDeleted, MkIndexLit>& ws = binary_watches && c.size() == 2 ? watches_bin : watches;
+    ws[~c[0]].push(Watcher(cr, c[1]));
+    ws[~c[1]].push(Watcher(cr, c[0]));
     if (c.learnt()) num_learnts++, learnts_literals += c.size();
     else            num_clauses++, clauses_literals += c.size();
 }
@@ -194,14 +327,15 @@ void Solver::attachClause(CRef cr){
 void Solver::detachClause(CRef cr, bool strict){
     const Clause& c = ca[cr];
     assert(c.size() > 1);
+    OccLists<Lit, vec<Watcher>, WatcherDeleted, MkIndexLit>& ws = binary_watches && c.size() == 2 ? watches_bin : watches;
     
     // Strict or lazy detaching:
     if (strict){
-        remove(watches[~c[0]], Watcher(cr, c[1]));
-        remove(watches[~c[1]], Watcher(cr, c[0]));
+        remove(ws[~c[0]], Watcher(cr, c[1]));
+        remove(ws[~c[1]], Watcher(cr, c[0]));
     }else{
-        watches.smudge(~c[0]);
-        watches.smudge(~c[1]);
+        ws.smudge(~c[0]);
+        ws.smudge(~c[1]);
     }
 
     if (c.learnt()) num_learnts--, learnts_literals -= c.size();
@@ -213,7 +347,9 @@ void Solver::removeClause(CRef cr) {
     Clause& c = ca[cr];
     detachClause(cr);
     // Don't leave pointers to free'd memory!
-    if (locked(c)) vardata[var(c[0])].reason = CRef_Undef;
+    if (locked(c)){
+        Lit implied = c.size() == 2 && reason(var(c[0])) != cr ? c[1] : c[0];
+        vardata[var(implied)].reason = CRef_Undef; }
     c.mark(1); 
     ca.free(cr);
 }
@@ -226,22 +362,70 @@ bool Solver::satisfied(const Clause& c) const {
     return false; }
 
 
-// Revert to the state at given level (keeping all assignment at 'level' but not beyond).
+// Revert to the state at given level (keeping all assignment at 'level' but not beyond). With
+// 'chrono', literals of lower levels may follow the start of 'level + 1' on the trail; these are kept
+// in order and propagated again.
 //
 void Solver::cancelUntil(int level) {
     if (decisionLevel() > level){
+        bool card_constrs = nAtMosts() > 0;
         for (int c = trail.size()-1; c >= trail_lim[level]; c--){
             Var      x  = var(trail[c]);
+            if (card_constrs && c < card_qhead){
+                const vec<int>& cs = card_occs[trail[c]];
+                for (int i = 0; i < cs.size(); i++)
+                    card_count[cs[i]]--; }
+            if (vardata[x].level <= level){
+                cancel_kept.push(trail[c]);
+                continue; }
             assigns [x] = l_Undef;
+            if (card_constrs && card_reason[x] >= 0){
+                // Explanations are not kept once the implication is undone:
+                if (reason(x) != CRef_Lazy)
+                    ca.free(reason(x));
+                card_reason[x] = -1; }
             if (phase_saving > 1 || (phase_saving == 1 && c > trail_lim.last()))
                 polarity[x] = sign(trail[c]);
             insertVarOrder(x); }
-        qhead = trail_lim[level];
+        qhead = card_qhead = trail_lim[level];
         trail.shrink(trail.size() - trail_lim[level]);
         trail_lim.shrink(trail_lim.size() - level);
+        for (int i = cancel_kept.size()-1; i >= 0; i--){
+            trail_pos[var(cancel_kept[i])] = trail.size();
+            trail.push_(cancel_kept[i]); }
+        cancel_kept.clear();
     } }
 
 
+// Returns the highest level among the literals of the conflicting clause 'confl' and whether it is the
+// level of only one of them. The literals of the two highest levels are moved to the front (and, if the
+// clause is attached, become its watches), as 'analyze()' and propagation below that level expect.
+//
+int Solver::conflictLevel(CRef confl, bool& single)
+{
+    Clause& c  = ca[confl];
+    int     i0 = 0, i1 = -1;
+    for (int i = 1; i < c.size(); i++)
+        if (level(var(c[i])) > level(var(c[i0])))
+            i1 = i0, i0 = i;
+        else if (i1 == -1 || level(var(c[i])) > level(var(c[i1])))
+            i1 = i;
+    single = i1 == -1 || level(var(c[i1])) < level(var(c[i0]));
+
+    if (i0 > 1 || i1 > 1){
+        bool attached = confl != card_confl;
+        if (attached) detachClause(confl, true);
+        Lit tmp = c[0]; c[0] = c[i0]; c[i0] = tmp;
+        if (i1 == 0) i1 = i0;
+        tmp = c[1]; c[1] = c[i1]; c[i1] = tmp;
+        if (attached) attachClause(confl);
+    }else if (i0 == 1){
+        Lit tmp = c[0]; c[0] = c[1]; c[1] = tmp; }
+
+    return level(var(c[0]));
+}
+
+
 //=================================================================================================
 // Major methods:
 
@@ -250,8 +434,23 @@ Lit Solver::pickBranchLit()
 {
     Var next = var_Undef;
 
+    if (branching == branch_vmtf){
+        // Random decision:
+        if (drand(random_seed) < random_var_freq && nVars() > 0){
+            next = irand(random_seed, nVars());
+            if (value(next) == l_Undef && decision[next])
+                rnd_decisions++;
+            else
+                next = var_Undef; }
+
+        // Most recently bumped unassigned variable (the heap below stays empty):
+        if (next == var_Undef){
+            while (vmtf_search != var_Undef && (value(vmtf_search) != l_Undef || !decision[vmtf_search]))
+                vmtf_search = vmtf_prev[vmtf_search];
+            next = vmtf_search; }
+
     // Random decision:
-    if (drand(random_seed) < random_var_freq && !order_heap.empty()){
+    }else if (drand(random_seed) < random_var_freq && !order_heap.empty()){
         next = order_heap[irand(random_seed,order_heap.size())];
         if (value(next) == l_Undef && decision[next])
             rnd_decisions++; }
@@ -304,17 +503,33 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
     int index   = trail.size() - 1;
 
     do{
+        if (p != lit_Undef)
+            confl = reasonClause(var(p));
         assert(confl != CRef_Undef); // (otherwise should be UIP)
         Clause& c = ca[confl];
 
-        if (c.learnt())
+        if (c.learnt()){
             claBumpActivity(c);
+            if (lbd_tiers && c.tier() != tier_core){
+                // The clause is in use: refresh its LBD, which may promote it to a better tier.
+                c.used(true);
+                uint32_t lbd = computeLBD(c);
+                if (lbd < c.lbd()){
+                    c.lbd(lbd);
+                    updateTier(c); }
+            }
+        }
 
         for (int j = (p == lit_Undef) ? 0 : 1; j < c.size(); j++){
             Lit q = c[j];
 
             if (!seen[var(q)] && level(var(q)) > 0){
-                varBumpActivity(var(q));
+                if (branching == branch_vmtf)
+                    vmtf_bumped.push(var(q));
+                else if (branching == branch_chb)
+                    chb_last[var(q)] = conflicts;
+                else
+                    varBumpActivity(var(q));
                 seen[var(q)] = 1;
                 if (level(var(q)) >= decisionLevel())
                     pathC++;
@@ -323,10 +538,11 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
             }
         }
         
-        // Select next clause to look at:
-        while (!seen[var(trail[index--])]);
-        p     = trail[index+1];
-        confl = reason(var(p));
+        // Select next clause to look at (skipping literals of lower levels assigned out of order):
+        do{
+            while (!seen[var(trail[index--])]);
+            p = trail[index+1];
+        }while (level(var(p)) < decisionLevel());
         seen[var(p)] = 0;
         pathC--;
 
@@ -349,7 +565,7 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
             if (reason(x) == CRef_Undef)
                 out_learnt[j++] = out_learnt[i];
             else{
-                Clause& c = ca[reason(var(out_learnt[i]))];
+                Clause& c = ca[reasonClause(x)];
                 for (int k = 1; k < c.size(); k++)
                     if (!seen[var(c[k])] && level(var(c[k])) > 0){
                         out_learnt[j++] = out_learnt[i];
@@ -361,6 +577,8 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
 
     max_literals += out_learnt.size();
     out_learnt.shrink(i - j);
+    if (out_learnt.size() > 1 && out_learnt.size() <= bin_min)
+        binMinimize(out_learnt);
     tot_literals += out_learnt.size();
 
     // Find correct backtrack level:
@@ -381,6 +599,93 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
     }
 
     for (int j = 0; j < analyze_toclear.size(); j++) seen[var(analyze_toclear[j])] = 0;    // ('seen[]' is now cleared)
+
+    if (branching == branch_vmtf)
+        vmtfBumpAnalyzed();
+}
+
+
+// Remove the literals '~l' of a learnt clause for which a binary clause '(out_learnt[0] | l)' exists:
+// resolving on them leaves the rest of the clause. Every literal 'l' is true, since '~l' is false.
+//
+void Solver::binMinimize(vec<Lit>& out_learnt)
+{
+    enum { seen_source = 1, seen_kept = 4 };
+    for (int i = 1; i < out_learnt.size(); i++)
+        seen[var(out_learnt[i])] = seen_kept;
+
+    // Binary clauses are in 'watches_bin' or, unless 'binary_watches' is set, among the other watchers,
+    // with the other literal as blocker:
+    Lit p = ~out_learnt[0];
+    for (int list = 0; list < 2; list++){
+        const vec<Watcher>& ws = list == 0 ? watches_bin[p] : watches[p];
+        for (int k = 0; k < ws.size(); k++){
+            Lit l = ws[k].blocker;
+            if (seen[var(l)] == seen_kept && value(l) == l_True){
+                const Clause& c = ca[ws[k].cref];
+                if (c.size() == 2 && c.mark() == 0 && (c[0] == l || c[1] == l))
+                    seen[var(l)] = seen_source; }
+        }
+    }
+
+    int i, j;
+    for (i = j = 1; i < out_learnt.size(); i++)
+        if (seen[var(out_learnt[i])] == seen_kept){
+            seen[var(out_learnt[i])] = seen_source;
+            out_learnt[j++] = out_learnt[i]; }
+    bin_min_literals += i - j;
+    out_learnt.shrink(i - j);
+}
+
+
+// Unlink 'v' from the VMTF queue (if it is in it) and append it at the end:
+//
+void Solver::vmtfEnqueue(Var v)
+{
+    if (vmtf_stamp[v] != 0){
+        if (v == vmtf_last){
+            vmtf_stamp[v] = ++vmtf_stamps;
+            return; }
+        Var p = vmtf_prev[v], n = vmtf_next[v];
+        if (p == var_Undef) vmtf_first   = n; else vmtf_next[p] = n;
+        vmtf_prev[n] = p;
+        if (vmtf_search == v) vmtf_search = p != var_Undef ? p : n;
+    }
+
+    vmtf_prev[v] = vmtf_last;
+    vmtf_next[v] = var_Undef;
+    if (vmtf_last == var_Undef) vmtf_first = v; else vmtf_next[vmtf_last] = v;
+    vmtf_last     = v;
+    vmtf_stamp[v] = ++vmtf_stamps;
+    if (value(v) == l_Undef && decision[v])
+        vmtf_search = v;
+}
+
+
+// Bump the variables of the last conflict analysis, keeping their relative order in the queue:
+//
+void Solver::vmtfBumpAnalyzed()
+{
+    sort(vmtf_bumped, VmtfStampLt(vmtf_stamp));
+    for (int i = 0; i < vmtf_bumped.size(); i++)
+        vmtfEnqueue(vmtf_bumped[i]);
+    vmtf_bumped.clear();
+}
+
+
+// CHB: every variable assigned since 'trail[from]' is rewarded by how recently it took part in a
+// conflict, more if this propagation ended in one:
+//
+void Solver::chbReward(int from, bool confl)
+{
+    double multiplier = confl ? 1.0 : 0.9;
+    for (int i = from; i < trail.size(); i++){
+        Var    v      = var(trail[i]);
+        double reward = multiplier / (conflicts - chb_last[v] + 1);
+        activity[v]   = (1 - chb_step) * activity[v] + chb_step * reward;
+        if (order_heap.inHeap(v))
+            order_heap.update(v);
+    }
 }
 
 
@@ -391,7 +696,7 @@ bool Solver::litRedundant(Lit p)
     assert(seen[var(p)] == seen_undef || seen[var(p)] == seen_source);
     assert(reason(var(p)) != CRef_Undef);
 
-    Clause*               c     = &ca[reason(var(p))];
+    Clause*               c     = &ca[reasonClause(var(p))];
     vec<ShrinkStackElem>& stack = analyze_stack;
     stack.clear();
 
@@ -420,7 +725,7 @@ bool Solver::litRedundant(Lit p)
             stack.push(ShrinkStackElem(i, p));
             i  = 0;
             p  = l;
-            c  = &ca[reason(var(p))];
+            c  = &ca[reasonClause(var(p))];
         }else{
             // Finished with current element 'p' and reason 'c':
             if (seen[var(p)] == seen_undef){
@@ -434,7 +739,7 @@ bool Solver::litRedundant(Lit p)
             // Continue with top element on stack:
             i  = stack.last().i;
             p  = stack.last().l;
-            c  = &ca[reason(var(p))];
+            c  = &ca[reasonClause(var(p))];
 
             stack.pop();
         }
@@ -470,7 +775,7 @@ void Solver::analyzeFinal(Lit p, LSet& out_conflict)
                 assert(level(x) > 0);
                 out_conflict.insert(~trail[i]);
             }else{
-                Clause& c = ca[reason(x)];
+                Clause& c = ca[reasonClause(x)];
                 for (int j = 1; j < c.size(); j++)
                     if (level(var(c[j])) > 0)
                         seen[var(c[j])] = 1;
@@ -483,15 +788,63 @@ void Solver::analyzeFinal(Lit p, LSet& out_conflict)
 }
 
 
-void Solver::uncheckedEnqueue(Lit p, CRef from)
+void Solver::uncheckedEnqueue(Lit p, int level, CRef from)
 {
     assert(value(p) == l_Undef);
+    assert(level <= decisionLevel());
     assigns[var(p)] = lbool(!sign(p));
-    vardata[var(p)] = mkVarData(from, decisionLevel());
+    vardata[var(p)] = mkVarData(from, level);
+    trail_pos[var(p)] = trail.size();
     trail.push_(p);
 }
 
 
+// Counts the newly assigned literal 'p' in the cardinality constraints containing it. A constraint
+// that reaches its bound forces all its unassigned literals to false.
+//
+CRef Solver::propagateAtMost(Lit p)
+{
+    const vec<int>& cs = card_occs[p];
+    for (int i = 0; i < cs.size(); i++)
+        card_count[cs[i]]++;
+
+    for (int i = 0; i < cs.size(); i++){
+        int c = cs[i];
+        if (card_count[c] > card_bound[c])
+            return card_confl = explainAtMost(c, p, false);
+        else if (card_count[c] == card_bound[c])
+            for (int j = card_start[c]; j < card_start[c+1]; j++)
+                if (value(card_lits[j]) == l_Undef){
+                    uncheckedEnqueue(~card_lits[j], CRef_Lazy);
+                    card_reason[var(card_lits[j])] = c; }
+    }
+
+    return CRef_Undef;
+}
+
+
+// Builds a clause from the true literals of cardinality constraint 'c' assigned before 'p'. If
+// 'implied', 'p' was forced by 'c' and the result is its reason (with 'p' first). Otherwise 'p'
+// exceeded the bound of 'c' and the result is a conflicting clause that also contains '~p'.
+//
+CRef Solver::explainAtMost(int c, Lit p, bool implied)
+{
+    Var x = var(p);
+    add_tmp.clear();
+    if (implied)
+        add_tmp.push(p);
+
+    for (int i = card_start[c]; i < card_start[c+1] && add_tmp.size() <= card_bound[c]; i++){
+        Var y = var(card_lits[i]);
+        if (value(card_lits[i]) == l_True && (level(y) < level(x) || trail_pos[y] < trail_pos[x] || (!implied && y == x)))
+            add_tmp.push(~card_lits[i]);
+    }
+    assert(add_tmp.size() == card_bound[c] + 1 || level(x) == 0);
+
+    return ca.alloc(add_tmp, false);
+}
+
+
 /*_________________________________________________________________________________________________
 |
 |  propagate : [void]  ->  [Clause*]
@@ -507,6 +860,8 @@ CRef Solver::propagate()
 {
     CRef    confl     = CRef_Undef;
     int     num_props = 0;
+    bool    card_constrs = nAtMosts() > 0;
+    card_confl        = CRef_Undef;
 
     while (qhead < trail.size()){
         Lit            p   = trail[qhead++];     // 'p' is enqueued fact to propagate.
@@ -514,7 +869,32 @@ CRef Solver::propagate()
         Watcher        *i, *j, *end;
         num_props++;
 
+        // Count 'p' in its cardinality constraints:
+        if (card_constrs){
+            if (card_occs[p].size() > 0)
+                confl = propagateAtMost(p);
+            card_qhead = qhead; }
+
+        // Binary clauses: the watcher holds the other literal, so the clause is never inspected:
+        if (binary_watches){
+            vec<Watcher>& wbin = watches_bin.lookup(p);
+            for (int k = 0; confl == CRef_Undef && k < wbin.size(); k++){
+                Lit imp = wbin[k].blocker;
+                if (value(imp) == l_False)
+                    confl = wbin[k].cref;
+                else if (value(imp) == l_Undef)
+                    uncheckedEnqueue(imp, level(var(p)), wbin[k].cref);
+            } }
+
+        if (confl != CRef_Undef){
+            qhead = trail.size();
+            break; }
+
         for (i = j = (Watcher*)ws, end = i + ws.size();  i != end;){
+            // Fetch the clause of a watcher ahead, unless its blocker will save the visit:
+            if (prefetch_dist > 0 && end - i > prefetch_dist && value(i[prefetch_dist].blocker) != l_True)
+                prefetch(ca.lea(i[prefetch_dist].cref));
+
             // Try to avoid inspecting the clause:
             Lit blocker = i->blocker;
             if (value(blocker) == l_True){
@@ -550,8 +930,23 @@ CRef Solver::propagate()
                 // Copy the remaining watches:
                 while (i < end)
                     *j++ = *i++;
-            }else
-                uncheckedEnqueue(first, cr);
+            }else{
+                // Below the current level (see 'chrono'), the implication belongs to the highest level of
+                // the false literals. That literal becomes the other watch, so both are undone together:
+                int lev = level(var(p));
+                if (lev < decisionLevel()){
+                    int max_k = 1;
+                    for (int k = 2; k < c.size(); k++)
+                        if (level(var(c[k])) > lev){
+                            lev   = level(var(c[k]));
+                            max_k = k; }
+                    if (max_k != 1){
+                        c[1] = c[max_k]; c[max_k] = false_lit;
+                        j--;
+                        watches[~c[1]].push(w); }
+                }
+                uncheckedEnqueue(first, lev, cr);
+            }
 
         NextClause:;
         }
@@ -571,6 +966,11 @@ CRef Solver::propagate()
 |  Description:
 |    Remove half of the learnt clauses, minus the clauses locked by the current assignment. Locked
 |    clauses are clauses that are reason to some assignment. Binary clauses are never removed.
+|
+|    With 'lbd_tiers', learnt clauses are tiered by their LBD (the number of decision levels among
+|    their literals, kept up to date in 'analyze()'). Core clauses are never removed and tier2
+|    clauses fall back to the local tier if they were not used since the previous reduction. Only
+|    the local tier is halved as above, and only it counts towards 'max_learnts'.
 |________________________________________________________________________________________________@*/
 struct reduceDB_lt { 
     ClauseAllocator& ca;
@@ -584,11 +984,31 @@ void Solver::reduceDB()
     double  extra_lim = cla_inc / learnts.size();    // Remove any clause below this activity
 
     sort(learnts, reduceDB_lt(ca));
+
+    // With 'lbd_tiers', only the local tier is reduced by activity:
+    int locals = 0;
+    if (lbd_tiers)
+        for (i = 0; i < learnts.size(); i++)
+            locals += ca[learnts[i]].tier() == tier_local;
+    int limit = lbd_tiers ? locals / 2 : learnts.size() / 2;
+    int pos   = 0;
+    tier_kept = 0;
+
     // Don't delete binary or locked clauses. From the rest, delete clauses from the first half
     // and clauses with activity smaller than 'extra_lim':
     for (i = j = 0; i < learnts.size(); i++){
         Clause& c = ca[learnts[i]];
-        if (c.size() > 2 && !locked(c) && (i < learnts.size() / 2 || c.activity() < extra_lim))
+        if (lbd_tiers && c.tier() != tier_local){
+            // Core clauses are kept for good, tier2 clauses only while they are used:
+            if (c.tier() == tier_mid && !c.used())
+                c.tier(tier_local);
+            c.used(false);
+            learnts[j++] = learnts[i];
+            tier_kept++;
+            continue; }
+
+        bool first_half = (lbd_tiers ? pos++ : i) < limit;
+        if (c.size() > 2 && !locked(c) && (first_half || c.activity() < extra_lim))
             removeClause(learnts[i]);
         else
             learnts[j++] = learnts[i];
@@ -608,11 +1028,19 @@ void Solver::removeSatisfied(vec<CRef>& cs)
         else{
             // Trim clause:
             assert(value(c[0]) == l_Undef && value(c[1]) == l_Undef);
+            bool was_long = c.size() > 2;
             for (int k = 2; k < c.size(); k++)
                 if (value(c[k]) == l_False){
                     c[k--] = c[c.size()-1];
                     c.pop();
                 }
+            if (binary_watches && was_long && c.size() == 2){
+                // Binary clauses are watched in 'watches_bin':
+                remove(watches[~c[0]], Watcher(cs[i], c[1]));
+                remove(watches[~c[1]], Watcher(cs[i], c[0]));
+                watches_bin[~c[0]].push(Watcher(cs[i], c[1]));
+                watches_bin[~c[1]].push(Watcher(cs[i], c[0]));
+            }
             cs[j++] = cs[i];
         }
     }
@@ -620,8 +1048,190 @@ void Solver::removeSatisfied(vec<CRef>& cs)
 }
 
 
+/*_________________________________________________________________________________________________
+|
+|  inprocess : ()  ->  [bool]
+|  
+|  Description:
+|    Vivify learnt clauses, newest first, until the propagations spent here reach 'inprocess_frac'
+|    of those made by the search since the previous call. A clause is detached and its literals are
+|    falsified one by one: a literal found false is implied by the others and dropped, and a true
+|    literal or a conflict ends the clause early. Each clause is vivified once.
+|  
+|  Output:
+|    FALSE if the clause set was found unsatisfiable at level 0.
+|________________________________________________________________________________________________@*/
+bool Solver::inprocess()
+{
+    assert(decisionLevel() == 0);
+    int64_t budget = (int64_t)((propagations - inprocess_props) * inprocess_frac);
+    if (budget < 1000)
+        // Not worth a round yet:
+        return true;
+
+    int64_t stop = propagations + budget;
+    int i, j;
+    for (i = j = learnts.size(); i > 0 && propagations < stop; ){
+        CRef cr = learnts[--i];
+        Clause& c = ca[cr];
+        if (c.vivified() || c.size() <= 2 || locked(c)){
+            learnts[--j] = cr;
+            continue; }
+
+        c.vivified(true);
+        detachClause(cr, true);
+        vivify_lits.clear();
+        for (int k = 0; k < c.size(); k++)
+            vivify_lits.push(c[k]);
+
+        bool sat = false;
+        vivify_out.clear();
+        for (int k = 0; k < vivify_lits.size(); k++){
+            Lit p = vivify_lits[k];
+            if (value(p) == l_True){
+                if (level(var(p)) == 0)
+                    sat = true;
+                else
+                    vivify_out.push(p);
+                break;
+            }else if (value(p) == l_False)
+                continue;
+
+            vivify_out.push(p);
+            newDecisionLevel();
+            uncheckedEnqueue(~p);
+            CRef confl = propagate();
+            if (confl != CRef_Undef){
+                if (confl == card_confl)
+                    ca.free(confl);
+                break; }
+        }
+        cancelUntil(0);
+
+        if (!sat && vivify_out.size() == vivify_lits.size()){
+            attachClause(cr);
+            learnts[--j] = cr;
+            continue; }
+
+        // The clause is satisfied or strengthened, replace it:
+        Clause& old = ca[cr];
+        float    act  = old.activity();
+        uint32_t lbd  = old.lbd();
+        uint32_t tier = old.tier();
+        old.mark(1);
+        ca.free(cr);
+        if (sat)
+            continue;
+
+        vivified_clauses++;
+        vivified_literals += vivify_lits.size() - vivify_out.size();
+        if (vivify_out.size() == 0)
+            return ok = false;
+        else if (vivify_out.size() == 1){
+            uncheckedEnqueue(vivify_out[0]);
+            if (propagate() != CRef_Undef)
+                return ok = false;
+        }else{
+            CRef nr = ca.alloc(vivify_out, true);
+            Clause& n = ca[nr];
+            n.activity() = act;
+            n.lbd(lbd < (uint32_t)vivify_out.size() ? lbd : vivify_out.size());
+            n.tier(tier);
+            n.vivified(true);
+            if (lbd_tiers)
+                updateTier(n);
+            attachClause(nr);
+            learnts[--j] = nr;
+        }
+    }
+
+    // Close the gap left by removed clauses:
+    int removed = j - i;
+    for (int k = i; k < learnts.size() - removed; k++)
+        learnts[k] = learnts[k + removed];
+    learnts.shrink(removed);
+
+    inprocess_props = propagations;
+    checkGarbage();
+    return true;
+}
+
+
+// Backward subsumption of the 'subsume_window' most recent learnt clauses by the new learnt clause 'c':
+//
+void Solver::subsumeLearnts(const vec<Lit>& c)
+{
+    for (int k = 0; k < c.size(); k++)
+        seen[var(c[k])] = 1 + sign(c[k]);
+
+    int i, j;
+    for (i = j = learnts.size() > subsume_window ? learnts.size() - subsume_window : 0; i < learnts.size(); i++){
+        Clause& d = ca[learnts[i]];
+        int     hits = 0;
+        if (d.size() >= c.size() && !locked(d))
+            for (int k = 0; k < d.size() && hits < c.size(); k++)
+                hits += seen[var(d[k])] == 1 + sign(d[k]);
+        if (hits == c.size()){
+            removeClause(learnts[i]);
+            subsumed_learnts++;
+        }else
+            learnts[j++] = learnts[i];
+    }
+    learnts.shrink(i - j);
+
+    for (int k = 0; k < c.size(); k++)
+        seen[var(c[k])] = 0;
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  importClauses : [void]  ->  [bool]
+|  
+|  Description:
+|    Add the clauses published by the other workers of 'exchange' as learnt clauses, without the
+|    literals that are false at the top level. Satisfied clauses are skipped, units are enqueued.
+|    Returns FALSE if the problem turned out to be unsatisfiable.
+|________________________________________________________________________________________________@*/
+bool Solver::importClauses()
+{
+    assert(decisionLevel() == 0);
+    vec<Lit> ps;
+    import_overruns += exchange->pull(exchange_id, [&](const vec<Lit>& c, uint32_t lbd){
+        if (!ok) return;
+        ps.clear();
+        for (int i = 0; i < c.size(); i++)
+            if (var(c[i]) >= nVars() || value(c[i]) == l_True)
+                return;
+            else if (value(c[i]) == l_Undef)
+                ps.push(c[i]);
+
+        imported_clauses++;
+        if (ps.size() == 0)
+            ok = false;
+        else if (ps.size() == 1)
+            uncheckedEnqueue(ps[0]);
+        else{
+            CRef cr = ca.alloc(ps, true);
+            if (lbd_tiers){
+                ca[cr].lbd(lbd < (uint32_t)ps.size() ? lbd : ps.size());
+                updateTier(ca[cr]); }
+            learnts.push(cr);
+            attachClause(cr);
+            claBumpActivity(ca[cr]);
+        }
+    });
+
+    return ok && (ok = propagate() == CRef_Undef);
+}
+
+
 void Solver::rebuildOrderHeap()
 {
+    if (branching == branch_vmtf){
+        vmtf_search = vmtf_last;
+        return; }
+
     vec<Var> vs;
     for (Var v = 0; v < nVars(); v++)
         if (decision[v] && value(v) == l_Undef)
@@ -667,7 +1277,7 @@ bool Solver::simplify()
                 trail[j++] = trail[i];
         trail.shrink(i - j);
         //printf("trail.size()= %d, qhead = %d\n", trail.size(), qhead);
-        qhead = trail.size();
+        qhead = card_qhead = trail.size();
 
         for (int i = 0; i < released_vars.size(); i++)
             seen[released_vars[i]] = 0;
@@ -708,24 +1318,69 @@ lbool Solver::search(int nof_conflicts)
     starts++;
 
     for (;;){
-        CRef confl = propagate();
+        int  played = qhead;
+        CRef confl  = propagate();
         if (confl != CRef_Undef){
             // CONFLICT
             conflicts++; conflictC++;
             if (decisionLevel() == 0) return l_False;
 
+            if (chrono > 0){
+                // Literals assigned out of order may put the conflict below the current level:
+                bool single;
+                int  confl_level = conflictLevel(confl, single);
+                if (confl_level == 0) return l_False;
+                if (single && confl != card_confl){
+                    // The clause was unit one level below; assign what propagation there would have:
+                    cancelUntil(confl_level - 1);
+                    Clause& c = ca[confl];
+                    uncheckedEnqueue(c[0], level(var(c[1])), confl);
+                    continue; }
+                cancelUntil(confl_level);
+                if (played > trail.size()) played = trail.size();
+            }
+
             learnt_clause.clear();
             analyze(confl, learnt_clause, backtrack_level);
-            cancelUntil(backtrack_level);
+            if (branching == branch_chb){
+                chbReward(played, true);
+                if (chb_step > 0.06) chb_step -= 1e-6; }
+            uint32_t lbd = lbd_tiers || dyn_restart || exchange != NULL ? computeLBD(learnt_clause) : 0;
+            if (exchange != NULL && exchange->accepts(learnt_clause.size(), lbd)){
+                exchange->push(exchange_id, learnt_clause, lbd);
+                exported_clauses++; }
+            if (dyn_restart){
+                // A trail much longer than usual may be close to a model, so postpone the next restart:
+                if (lbd_queue.isFull() && trail_queue.isFull() && trail.size() > block_r * trail_queue.avg()){
+                    lbd_queue.clear();
+                    blocked_restarts++; }
+                trail_queue.push(trail.size());
+                lbd_queue.push(lbd);
+                sum_lbd += lbd;
+            }
+            if (confl == card_confl)
+                // Explanations of cardinality conflicts are not kept:
+                ca.free(confl);
+            if (chrono > 0 && decisionLevel() - backtrack_level >= chrono){
+                // Keep the assignments of the levels in between; the learnt clause is asserted out of order:
+                cancelUntil(decisionLevel() - 1);
+                chrono_backtracks++;
+            }else
+                cancelUntil(backtrack_level);
 
             if (learnt_clause.size() == 1){
-                uncheckedEnqueue(learnt_clause[0]);
+                uncheckedEnqueue(learnt_clause[0], 0, CRef_Undef);
             }else{
+                if (inprocessing)
+                    subsumeLearnts(learnt_clause);
                 CRef cr = ca.alloc(learnt_clause, true);
+                if (lbd_tiers){
+                    ca[cr].lbd(lbd);
+                    updateTier(ca[cr]); }
                 learnts.push(cr);
                 attachClause(cr);
                 claBumpActivity(ca[cr]);
-                uncheckedEnqueue(learnt_clause[0], cr);
+                uncheckedEnqueue(learnt_clause[0], backtrack_level, cr);
             }
 
             varDecayActivity();
@@ -745,8 +1400,13 @@ lbool Solver::search(int nof_conflicts)
 
         }else{
             // NO CONFLICT
-            if ((nof_conflicts >= 0 && conflictC >= nof_conflicts) || !withinBudget()){
-                // Reached bound on number of conflicts:
+            if (branching == branch_chb)
+                chbReward(played, false);
+
+            if ((nof_conflicts >= 0 && conflictC >= nof_conflicts) || !withinBudget()
+                || (dyn_restart && lbd_queue.isFull() && lbd_queue.avg() * restart_k > (double)sum_lbd / conflicts)){
+                // Reached bound on number of conflicts, or recent conflicts are worse than average:
+                lbd_queue.clear();
                 progress_estimate = progressEstimate();
                 cancelUntil(0);
                 return l_Undef; }
@@ -755,7 +1415,11 @@ lbool Solver::search(int nof_conflicts)
             if (decisionLevel() == 0 && !simplify())
                 return l_False;
 
-            if (learnts.size()-nAssigns() >= max_learnts)
+            // Strengthen learnt clauses:
+            if (inprocessing && decisionLevel() == 0 && !inprocess())
+                return l_False;
+
+            if (learnts.size()-tier_kept-nAssigns() >= max_learnts)
                 // Reduce the set of learnt clauses:
                 reduceDB();
 
@@ -859,11 +1523,18 @@ lbool Solver::solve_()
         printf("===============================================================================\n");
     }
 
+    if (dyn_restart){
+        lbd_queue.initSize(lbd_window);
+        trail_queue.initSize(trail_window); }
+
     // Search:
     int curr_restarts = 0;
     while (status == l_Undef){
+        if (exchange != NULL && !importClauses()){
+            status = l_False;
+            break; }
         double rest_base = luby_restart ? luby(restart_inc, curr_restarts) : pow(restart_inc, curr_restarts);
-        status = search(rest_base * restart_first);
+        status = search(dyn_restart ? -1 : rest_base * restart_first);
         if (!withinBudget()) break;
         curr_restarts++;
     }
@@ -993,10 +1664,36 @@ void Solver::printStats() const
     double cpu_time = cpuTime();
     double mem_used = memUsedPeak();
     printf("restarts              : %" PRIu64 "\n", starts);
+    if (dyn_restart) printf("blocked restarts      : %" PRIu64 "\n", blocked_restarts);
+    if (inprocessing){
+        printf("vivified clauses      : %-12" PRIu64 "   (%" PRIu64 " literals removed)\n", vivified_clauses, vivified_literals);
+        printf("subsumed learnts      : %" PRIu64 "\n", subsumed_learnts); }
+    if (exchange != NULL)
+        printf("shared clauses        : %-12" PRIu64 "   (%" PRIu64 " imported, %" PRIu64 " overruns)\n", exported_clauses, imported_clauses, import_overruns);
     printf("conflicts             : %-12" PRIu64 "   (%.0f /sec)\n", conflicts   , conflicts   /cpu_time);
     printf("decisions             : %-12" PRIu64 "   (%4.2f %% random) (%.0f /sec)\n", decisions, (float)rnd_decisions*100 / (float)decisions, decisions   /cpu_time);
     printf("propagations          : %-12" PRIu64 "   (%.0f /sec)\n", propagations, propagations/cpu_time);
     printf("conflict literals     : %-12" PRIu64 "   (%4.2f %% deleted)\n", tot_literals, (max_literals - tot_literals)*100 / (double)max_literals);
+    if (bin_min > 0)
+        printf("binary strengthening  : %-12" PRIu64 "   (literals deleted)\n", bin_min_literals);
+    if (chrono > 0)
+        printf("chrono backtracks     : %-12" PRIu64 "   (%4.2f %% of conflicts)\n", chrono_backtracks, chrono_backtracks*100 / (double)conflicts);
+    if (lbd_tiers){
+        int tiers[3] = { 0, 0, 0 };
+        for (int i = 0; i < learnts.size(); i++)
+            tiers[ca[learnts[i]].tier()]++;
+        printf("learnt clauses        : %-12d   (core %d, tier2 %d, local %d)\n", learnts.size(), tiers[tier_core], tiers[tier_mid], tiers[tier_local]);
+    }
+    if (gc_runs > 0){
+        printf("garbage collections   : %-12" PRIu64 "   (%.3f s, longest pause %.2f ms)\n", gc_runs, gc_time, gc_max_pause * 1000);
+        int last = gc_buckets - 1;
+        while (gc_pauses[last] == 0) last--;
+        for (int i = 0; i <= last; i++)
+            if (i < gc_buckets - 1)
+                printf("  pauses < %4d ms     : %" PRIu64 "\n", 1 << i, gc_pauses[i]);
+            else
+                printf("  pauses >= %3d ms     : %" PRIu64 "\n", 1 << (i - 1), gc_pauses[i]);
+    }
     if (mem_used != 0) printf("Memory used           : %.2f MB\n", mem_used);
     printf("CPU time              : %g s\n", cpu_time);
 }
@@ -1005,62 +1702,120 @@ void Solver::printStats() const
 //=================================================================================================
 // Garbage Collection methods:
 
+// Runs 'f(begin, end)' for consecutive slices of '[0, n)' on up to 'threads' threads, the first one
+// on this thread. Slices are not made smaller than 'grain', it is not worth starting a thread for less.
+template<class F>
+static void parallelFor(int threads, int n, int grain, const F& f)
+{
+    if (threads > n / grain) threads = n / grain;
+    if (threads < 1)         threads = 1;
+
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; t++)
+        workers.emplace_back(f, (int)((int64_t)n * t / threads), (int)((int64_t)n * (t + 1) / threads));
+    f(0, (int)((int64_t)n / threads));
+    for (size_t t = 0; t < workers.size(); t++)
+        workers[t].join();
+}
+
+
 void Solver::relocAll(ClauseAllocator& to)
 {
+    watches.cleanAll();
+    watches_bin.cleanAll();
+
+    // All learnt and original clauses get their place in 'to' first, which is cheap, in the order of
+    // the lists. A clause relocated before (see 'SimpSolver::relocAll()') keeps its place:
+    //
+    vec<CRef> from, dest;
+    int i, j;
+    for (i = j = 0; i < learnts.size(); i++)
+        if (!isRemoved(learnts[i]))
+            learnts[j++] = learnts[i];
+    learnts.shrink(i - j);
+    for (i = j = 0; i < clauses.size(); i++)
+        if (!isRemoved(clauses[i]))
+            clauses[j++] = clauses[i];
+    clauses.shrink(i - j);
+
+    for (int k = 0; k < 2; k++){
+        const vec<CRef>& cs = k == 0 ? learnts : clauses;
+        for (i = 0; i < cs.size(); i++)
+            if (!ca[cs[i]].reloced()){
+                from.push(cs[i]);
+                dest.push(to.reserve(ca[cs[i]])); }
+    }
+
+    // Copying the clauses and updating the references does not allocate, the threads split the work:
+    //
+    parallelFor(gc_threads, from.size(), 4096, [&](int begin, int end){
+        for (int k = begin; k < end; k++){
+            to.copy(dest[k], ca[from[k]]);
+            ca[from[k]].relocate(dest[k]); } });
+
     // All watchers:
     //
-    watches.cleanAll();
-    for (int v = 0; v < nVars(); v++)
-        for (int s = 0; s < 2; s++){
-            Lit p = mkLit(v, s);
-            vec<Watcher>& ws = watches[p];
-            for (int j = 0; j < ws.size(); j++)
-                ca.reloc(ws[j].cref, to);
-        }
+    parallelFor(gc_threads, nVars(), 1024, [&](int begin, int end){
+        for (int v = begin; v < end; v++)
+            for (int s = 0; s < 2; s++){
+                Lit p = mkLit(v, s);
+                vec<Watcher>& ws = watches[p];
+                for (int k = 0; k < ws.size(); k++)
+                    ws[k].cref = ca[ws[k].cref].relocation();
+                vec<Watcher>& wbin = watches_bin[p];
+                for (int k = 0; k < wbin.size(); k++)
+                    wbin[k].cref = ca[wbin[k].cref].relocation();
+            } });
+
+    // All learnt and original:
+    //
+    for (int k = 0; k < 2; k++){
+        vec<CRef>& cs = k == 0 ? learnts : clauses;
+        parallelFor(gc_threads, cs.size(), 4096, [&](int begin, int end){
+            for (int l = begin; l < end; l++)
+                cs[l] = ca[cs[l]].relocation(); });
+    }
 
     // All reasons:
     //
-    for (int i = 0; i < trail.size(); i++){
+    for (i = 0; i < trail.size(); i++){
         Var v = var(trail[i]);
 
         // Note: it is not safe to call 'locked()' on a relocated clause. This is why we keep
         // 'dangling' reasons here. It is safe and does not hurt.
-        if (reason(v) != CRef_Undef && (ca[reason(v)].reloced() || locked(ca[reason(v)]))){
+        if (reason(v) != CRef_Undef && reason(v) != CRef_Lazy && (ca[reason(v)].reloced() || locked(ca[reason(v)]))){
             assert(!isRemoved(reason(v)));
             ca.reloc(vardata[v].reason, to);
         }
     }
+}
 
-    // All learnt:
-    //
-    int i, j;
-    for (i = j = 0; i < learnts.size(); i++)
-        if (!isRemoved(learnts[i])){
-            ca.reloc(learnts[i], to);
-            learnts[j++] = learnts[i];
-        }
-    learnts.shrink(i - j);
 
-    // All original:
-    //
-    for (i = j = 0; i < clauses.size(); i++)
-        if (!isRemoved(clauses[i])){
-            ca.reloc(clauses[i], to);
-            clauses[j++] = clauses[i];
-        }
-    clauses.shrink(i - j);
+void Solver::recordGC(double seconds)
+{
+    int bucket = 0;
+    while (bucket < gc_buckets - 1 && seconds * 1000 >= (1 << bucket))
+        bucket++;
+    gc_runs++;
+    gc_pauses[bucket]++;
+    gc_time += seconds;
+    if (seconds > gc_max_pause)
+        gc_max_pause = seconds;
 }
 
 
 void Solver::garbageCollect()
 {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
     // Initialize the next region to a size corresponding to the estimated utilization degree. This
     // is not precise but should avoid some unnecessary reallocations for the new region:
-    ClauseAllocator to(ca.size() - ca.wasted()); 
+    ClauseAllocator to(ca.size() - ca.wasted(), ca.hugePages(), ca.aligned()); 
 
     relocAll(to);
     if (verbosity >= 2)
-        printf("|  Garbage collection:   %12d bytes => %12d bytes             |\n", 
-               ca.size()*ClauseAllocator::Unit_Size, to.size()*ClauseAllocator::Unit_Size);
+        printf("|  Garbage collection:   %12" PRIu64 " bytes => %12" PRIu64 " bytes             |\n", 
+               (uint64_t)ca.size()*ClauseAllocator::Unit_Size, (uint64_t)to.size()*ClauseAllocator::Unit_Size);
     to.moveTo(ca);
+    recordGC(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
 }
@@ -21,13 +21,22 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #ifndef Minisat_Solver_h
 #define Minisat_Solver_h
 
+#include <atomic>
+
 #include "minisat/mtl/Vec.h"
 #include "minisat/mtl/Heap.h"
+#include "minisat/mtl/BoundedQueue.h"
 #include "minisat/mtl/Alg.h"
 #include "minisat/mtl/IntMap.h"
 #include "minisat/utils/Options.h"
 #include "minisat/core/SolverTypes.h"
+#include "minisat/core/ClauseExchange.h"
+
 
+// Children per node of the variable order heap (2, 4 or 8), chosen when the library is built:
+#ifndef MINISAT_HEAP_ARITY
+#define MINISAT_HEAP_ARITY 2
+#endif
 
 namespace Minisat {
 
@@ -55,6 +64,9 @@ public:
     bool    addClause (Lit p, Lit q, Lit r, Lit s);             // Add a quaternary clause to the solver. 
     bool    addClause_(      vec<Lit>& ps);                     // Add a clause to the solver without making superflous internal copy. Will
                                                                 // change the passed vector 'ps'.
+    bool    addAtMost (const vec<Lit>& ps, int k);              // Add the cardinality constraint 'sum(ps) <= k'. Duplicate literals count once.
+    bool    setAtMostBound(int c, int k);                       // Tighten the bound of the c-th cardinality constraint (in order of addition)
+                                                                // between calls to 'solve()'. Bounds may never be relaxed.
 
     // Solving:
     //
@@ -90,6 +102,11 @@ public:
     void    setPolarity    (Var v, lbool b); // Declare which polarity the decision heuristic should use for a variable. Requires mode 'polarity_user'.
     void    setDecisionVar (Var v, bool b);  // Declare if a variable should be eligible for selection in the decision heuristic.
 
+    // Solution hints:
+    //
+    void    suggestPhase   (Var v, bool b);     // Seed the saved phase of a variable. Unlike 'setPolarity()', phase saving may override it later.
+    void    bumpActivity   (Var v, double inc); // Seed the decision heuristic by raising the activity of a variable.
+
     // Read state:
     //
     lbool   value      (Var x) const;       // The current value of a variable.
@@ -99,8 +116,10 @@ public:
     int     nAssigns   ()      const;       // The current number of assigned literals.
     int     nClauses   ()      const;       // The current number of original clauses.
     int     nLearnts   ()      const;       // The current number of learnt clauses.
+    int     nAtMosts   ()      const;       // The current number of cardinality constraints.
     int     nVars      ()      const;       // The current number of variables.
     int     nFreeVars  ()      const;
+    uint64_t arenaBytes()      const;       // The size of the clause arena in bytes, wasted space included.
     void    printStats ()      const;       // Print some current statistics to standard output.
 
     // Resource contraints:
@@ -111,6 +130,11 @@ public:
     void    interrupt();          // Trigger a (potentially asynchronous) interruption of the solver.
     void    clearInterrupt();     // Clear interrupt indicator flag.
 
+    // Clause sharing:
+    //
+    void    setExchange(ClauseExchange* x, int worker); // Export short learnt clauses to 'x' as 'worker' and import those of the
+                                                        // other workers at every restart. NULL stops sharing.
+
     // Memory managment:
     //
     virtual void garbageCollect();
@@ -132,14 +156,32 @@ public:
     double    random_seed;
     bool      luby_restart;
     int       ccmin_mode;         // Controls conflict clause minimization (0=none, 1=basic, 2=deep).
+    int       bin_min;            // Strengthen learnt clauses of at most this size with binary clauses (0=off).
     int       phase_saving;       // Controls the level of phase saving (0=none, 1=limited, 2=full).
+    int       chrono;             // Backtrack only one level when a backjump would undo at least this many levels (0=off).
     bool      rnd_pol;            // Use random polarities for branching heuristics.
     bool      rnd_init_act;       // Initialize variable activities with a small random value.
+    bool      binary_watches;     // Propagate binary clauses from separate watcher lists. Must be set before clauses are added.
+    enum { branch_vsids = 0, branch_vmtf = 1, branch_chb = 2 };
+    int       branching;          // Decision heuristic (VSIDS, VMTF or CHB). Must be set before variables are created.
     double    garbage_frac;       // The fraction of wasted memory allowed before a garbage collection is triggered.
+    int       gc_threads;         // Number of threads copying clauses and updating references in 'garbageCollect()'.
+    int       prefetch_dist;      // Prefetch the clause of the watcher this far ahead in 'propagate()' (0 = off).
     int       min_learnts_lim;    // Minimum number to set the learnts limit to.
+    bool      lbd_tiers;          // Keep learnt clauses in tiers by LBD instead of by activity alone.
+    int       core_lbd;           // Learnt clauses with at most this LBD are kept for good.                                   (default 2)
+    int       tier2_lbd;          // Learnt clauses with at most this LBD are kept while they are used.                        (default 6)
 
     int       restart_first;      // The initial restart limit.                                                                (default 100)
     double    restart_inc;        // The factor with which the restart limit is multiplied in each restart.                    (default 1.5)
+    bool      dyn_restart;        // Restart on the recent LBD average instead of the Luby/geometric schedule.
+    double    restart_k;          // Restart when the recent LBD average times this exceeds the global one.                    (default 0.8)
+    double    block_r;            // Block a restart when the trail exceeds this times the recent average trail size.          (default 1.4)
+    int       lbd_window;         // Number of conflicts in the recent LBD average.                                            (default 50)
+    int       trail_window;       // Number of conflicts in the recent trail size average.                                     (default 5000)
+    bool      inprocessing;       // Vivify learnt clauses at restarts and remove learnts subsumed by new ones.
+    double    inprocess_frac;     // Propagations spent on vivification, as a fraction of those spent searching.              (default 0.02)
+    int       subsume_window;     // Number of most recent learnt clauses checked against each new one.                        (default 20)
     double    learntsize_factor;  // The intitial limit for learnt clauses is a factor of the original clauses.                (default 1 / 3)
     double    learntsize_inc;     // The limit for learnt clauses is multiplied with this factor each restart.                 (default 1.1)
 
@@ -148,8 +190,15 @@ public:
 
     // Statistics: (read-only member variable)
     //
-    uint64_t solves, starts, decisions, rnd_decisions, propagations, conflicts;
+    uint64_t solves, starts, decisions, rnd_decisions, propagations, conflicts, blocked_restarts;
     uint64_t dec_vars, num_clauses, num_learnts, clauses_literals, learnts_literals, max_literals, tot_literals;
+    uint64_t vivified_clauses, vivified_literals, subsumed_learnts;
+    uint64_t exported_clauses, imported_clauses, import_overruns;
+    uint64_t bin_min_literals;                                 // Literals removed from learnt clauses by 'binMinimize()'.
+    uint64_t chrono_backtracks;                                // Conflicts after which only one level was undone ('chrono').
+    enum { gc_buckets = 12 };
+    uint64_t gc_runs, gc_pauses[gc_buckets];                   // Garbage collections; 'gc_pauses[i]' counts pauses below 2^i ms.
+    double   gc_time, gc_max_pause;                            // Seconds spent in garbage collection, longest pause.
 
 protected:
 
@@ -173,12 +222,20 @@ protected:
         bool operator()(const Watcher& w) const { return ca[w.cref].mark() == 1; }
     };
 
+    struct VmtfStampLt {
+        const VMap<uint64_t>& stamp;
+        bool operator () (Var x, Var y) const { return stamp[x] < stamp[y]; }
+        VmtfStampLt(const VMap<uint64_t>& s) : stamp(s) { }
+    };
+
     struct VarOrderLt {
         const IntMap<Var, double>&  activity;
         bool operator () (Var x, Var y) const { return activity[x] > activity[y]; }
         VarOrderLt(const IntMap<Var, double>&  act) : activity(act) { }
     };
 
+    enum { tier_local = 0, tier_mid = 1, tier_core = 2 };
+
     struct ShrinkStackElem {
         uint32_t i;
         Lit      l;
@@ -201,8 +258,40 @@ protected:
     VMap<VarData>       vardata;          // Stores reason and level for each variable.
     OccLists<Lit, vec<Watcher>, WatcherDeleted, MkIndexLit>
                         watches;          // 'watches[lit]' is a list of constraints watching 'lit' (will go there if literal becomes true).
+    OccLists<Lit, vec<Watcher>, WatcherDeleted, MkIndexLit>
+                        watches_bin;      // Binary clauses if 'binary_watches' is set. The blocker of a watcher is the other literal.
 
-    Heap<Var,VarOrderLt>order_heap;       // A priority queue of variables ordered with respect to the variable activity.
+    Heap<Var,VarOrderLt,MkIndexDefault<Var>,MINISAT_HEAP_ARITY>
+                        order_heap;       // A priority queue of variables ordered with respect to the variable activity.
+
+    // VMTF: the variables in a queue from the least ('vmtf_first') to the most recently bumped ('vmtf_last').
+    //
+    VMap<Var>           vmtf_prev;
+    VMap<Var>           vmtf_next;
+    VMap<uint64_t>      vmtf_stamp;       // Increases along the queue.
+    Var                 vmtf_first;
+    Var                 vmtf_last;
+    Var                 vmtf_search;      // Every decision variable after this one in the queue is assigned.
+    uint64_t            vmtf_stamps;
+    vec<Var>            vmtf_bumped;      // Variables met by the current 'analyze()'.
+
+    // CHB: 'activity' holds the Q score of each variable and 'order_heap' is ordered by it.
+    //
+    VMap<uint64_t>      chb_last;         // Value of 'conflicts' when the variable last took part in conflict analysis.
+    double              chb_step;         // Step size of the Q score update, decays from 0.4 to 0.06.
+
+    // Cardinality constraints: constraint 'c' is 'sum(card_lits[card_start[c] .. card_start[c+1]-1]) <= card_bound[c]'.
+    //
+    vec<Lit>            card_lits;
+    vec<int>            card_start;
+    vec<int>            card_bound;
+    vec<int>            card_count;       // Number of true literals of each constraint among the first 'card_qhead' trail entries.
+    IntMap<Lit, vec<int>, MkIndexLit>
+                        card_occs;        // 'card_occs[lit]' lists the cardinality constraints containing 'lit'.
+    VMap<int>           card_reason;      // The cardinality constraint that implied a variable, or -1. The reason clause is built on demand.
+    VMap<int>           trail_pos;        // Index of each assigned variable in 'trail'.
+    int                 card_qhead;       // Head of the cardinality queue (trail entries before it are included in 'card_count').
+    CRef                card_confl;       // Explanation of the last cardinality conflict, freed once it has been analyzed.
 
     bool                ok;               // If FALSE, the constraints are already unsatisfiable. No part of the solver state may be used!
     double              cla_inc;          // Amount to bump next clause with.
@@ -225,8 +314,18 @@ protected:
     vec<ShrinkStackElem>analyze_stack;
     vec<Lit>            analyze_toclear;
     vec<Lit>            add_tmp;
+    vec<Lit>            cancel_kept;      // Literals assigned below the backtrack level, put back on the trail by 'cancelUntil()'.
+    vec<uint64_t>       lbd_seen;         // Per decision level: the value of 'lbd_stamp' when it was last counted.
+    uint64_t            lbd_stamp;
 
     double              max_learnts;
+    BoundedQueue<uint32_t> lbd_queue;     // LBDs of the most recent conflicts ('dyn_restart').
+    BoundedQueue<uint32_t> trail_queue;   // Trail sizes at the most recent conflicts ('dyn_restart').
+    uint64_t            sum_lbd;          // Sum of the LBDs of all conflicts ('dyn_restart').
+    int64_t             inprocess_props;  // Value of 'propagations' at the end of the last 'inprocess()'.
+    vec<Lit>            vivify_lits;
+    vec<Lit>            vivify_out;
+    int                 tier_kept;        // Number of core and tier2 clauses after the last 'reduceDB()', not counted against 'max_learnts'.
     double              learntsize_adjust_confl;
     int                 learntsize_adjust_cnt;
 
@@ -234,7 +333,12 @@ protected:
     //
     int64_t             conflict_budget;    // -1 means no budget.
     int64_t             propagation_budget; // -1 means no budget.
-    bool                asynch_interrupt;
+    std::atomic<bool>   asynch_interrupt;
+
+    // Clause sharing:
+    //
+    ClauseExchange*     exchange;         // NULL unless sharing clauses.
+    int                 exchange_id;      // This solver's worker number in 'exchange'.
 
     // Main internal methods:
     //
@@ -242,16 +346,27 @@ protected:
     Lit      pickBranchLit    ();                                                      // Return the next decision variable.
     void     newDecisionLevel ();                                                      // Begins a new decision level.
     void     uncheckedEnqueue (Lit p, CRef from = CRef_Undef);                         // Enqueue a literal. Assumes value of literal is undefined.
+    void     uncheckedEnqueue (Lit p, int level, CRef from);                           // Enqueue a literal at a level below the current one ('chrono').
     bool     enqueue          (Lit p, CRef from = CRef_Undef);                         // Test if fact 'p' contradicts current state, enqueue otherwise.
     CRef     propagate        ();                                                      // Perform unit propagation. Returns possibly conflicting clause.
+    CRef     propagateAtMost  (Lit p);                                                 // Count 'p' in its cardinality constraints. Returns possibly conflicting clause.
+    CRef     explainAtMost    (int c, Lit p, bool implied);                            // Clause over the true literals of 'c' assigned before 'p' (see definition).
     void     cancelUntil      (int level);                                             // Backtrack until a certain level.
+    int      conflictLevel    (CRef confl, bool& single);                              // Highest level in a conflicting clause, moved to its front ('chrono').
     void     analyze          (CRef confl, vec<Lit>& out_learnt, int& out_btlevel);    // (bt = backtrack)
     void     analyzeFinal     (Lit p, LSet& out_conflict);                             // COULD THIS BE IMPLEMENTED BY THE ORDINARIY "analyze" BY SOME REASONABLE GENERALIZATION?
     bool     litRedundant     (Lit p);                                                 // (helper method for 'analyze()')
+    void     binMinimize      (vec<Lit>& out_learnt);                                  // (helper method for 'analyze()')
     lbool    search           (int nof_conflicts);                                     // Search for a given number of conflicts.
     lbool    solve_           ();                                                      // Main solve method (assumptions given in 'assumptions').
     void     reduceDB         ();                                                      // Reduce the set of learnt clauses.
+    template<class Lits>
+    uint32_t computeLBD       (const Lits& c);                                         // Number of distinct decision levels in 'c'.
+    void     updateTier       (Clause& c);                                             // Move 'c' to the tier of its current LBD if that is better.
     void     removeSatisfied  (vec<CRef>& cs);                                         // Shrink 'cs' to contain only non-satisfied clauses.
+    bool     inprocess        ();                                                      // Vivify learnt clauses within the propagation budget (at level 0).
+    void     subsumeLearnts   (const vec<Lit>& c);                                     // Remove recent learnt clauses subsumed by 'c'.
+    bool     importClauses    ();                                                      // Add the clauses shared by other workers (at level 0).
     void     rebuildOrderHeap ();
 
     // Maintaining Variable/Clause activity:
@@ -259,6 +374,9 @@ protected:
     void     varDecayActivity ();                      // Decay all variables with the specified factor. Implemented by increasing the 'bump' value instead.
     void     varBumpActivity  (Var v, double inc);     // Increase a variable with the current 'bump' value.
     void     varBumpActivity  (Var v);                 // Increase a variable with the current 'bump' value.
+    void     vmtfEnqueue      (Var v);                 // Move a variable to the end of the VMTF queue.
+    void     vmtfBumpAnalyzed ();                      // Move the variables met by 'analyze()' to the end of the queue, in their order.
+    void     chbReward        (int from, bool confl);  // Update the Q scores of the variables assigned since 'trail[from]'.
     void     claDecayActivity ();                      // Decay all clauses with the specified factor. Implemented by increasing the 'bump' value instead.
     void     claBumpActivity  (Clause& c);             // Increase a clause with the current 'bump' value.
 
@@ -275,11 +393,13 @@ protected:
     //
     int      decisionLevel    ()      const; // Gives the current decisionlevel.
     uint32_t abstractLevel    (Var x) const; // Used to represent an abstraction of sets of decision levels.
-    CRef     reason           (Var x) const;
+    CRef     reason           (Var x) const;   // May be 'CRef_Lazy'; use 'reasonClause()' to access the clause.
+    CRef     reasonClause     (Var x);         // The reason clause of 'x' with 'x' first, building explanations of cardinality propagations on demand.
     int      level            (Var x) const;
     double   progressEstimate ()      const; // DELETE THIS ?? IT'S NOT VERY USEFUL ...
     bool     withinBudget     ()      const;
     void     relocAll         (ClauseAllocator& to);
+    void     recordGC         (double seconds); // Adds a garbage collection pause to the statistics.
 
     // Static helpers:
     //
@@ -302,9 +422,21 @@ protected:
 
 inline CRef Solver::reason(Var x) const { return vardata[x].reason; }
 inline int  Solver::level (Var x) const { return vardata[x].level; }
+inline CRef Solver::reasonClause(Var x) {
+    if (vardata[x].reason == CRef_Lazy)
+        vardata[x].reason = explainAtMost(card_reason[x], mkLit(x, value(x) == l_False), true);
+    else if (vardata[x].reason != CRef_Undef){
+        // Binary reasons are propagated without touching the clause; put the implied literal first:
+        Clause& c = ca[vardata[x].reason];
+        if (c.size() == 2 && var(c[0]) != x){
+            Lit tmp = c[0]; c[0] = c[1]; c[1] = tmp; } }
+    return vardata[x].reason; }
 
 inline void Solver::insertVarOrder(Var x) {
-    if (!order_heap.inHeap(x) && decision[x]) order_heap.insert(x); }
+    if (branching == branch_vmtf){
+        if (decision[x] && (vmtf_search == var_Undef || vmtf_stamp[x] > vmtf_stamp[vmtf_search]))
+            vmtf_search = x;
+    }else if (!order_heap.inHeap(x) && decision[x]) order_heap.insert(x); }
 
 inline void Solver::varDecayActivity() { var_inc *= (1 / var_decay); }
 inline void Solver::varBumpActivity(Var v) { varBumpActivity(v, var_inc); }
@@ -327,6 +459,23 @@ inline void Solver::claBumpActivity (Clause& c) {
                 ca[learnts[i]].activity() *= 1e-20;
             cla_inc *= 1e-20; } }
 
+template<class Lits>
+inline uint32_t Solver::computeLBD(const Lits& c) {
+    lbd_seen.growTo(decisionLevel() + 1, 0);
+    lbd_stamp++;
+    uint32_t lbd = 0;
+    for (int i = 0; i < c.size(); i++){
+        int l = level(var(c[i]));
+        if (lbd_seen[l] != lbd_stamp){
+            lbd_seen[l] = lbd_stamp;
+            lbd++; } }
+    return lbd; }
+
+inline void Solver::updateTier(Clause& c) {
+    uint32_t t = (int)c.lbd() <= core_lbd ? tier_core : (int)c.lbd() <= tier2_lbd ? tier_mid : tier_local;
+    if (t > c.tier())
+        c.tier(t); }
+
 inline void Solver::checkGarbage(void){ return checkGarbage(garbage_frac); }
 inline void Solver::checkGarbage(double gf){
     if (ca.wasted() > ca.size() * gf)
@@ -342,8 +491,14 @@ inline bool     Solver::addClause       (Lit p, Lit q, Lit r)   { add_tmp.clear(
 inline bool     Solver::addClause       (Lit p, Lit q, Lit r, Lit s){ add_tmp.clear(); add_tmp.push(p); add_tmp.push(q); add_tmp.push(r); add_tmp.push(s); return addClause_(add_tmp); }
 
 inline bool     Solver::isRemoved       (CRef cr)         const { return ca[cr].mark() == 1; }
-inline bool     Solver::locked          (const Clause& c) const { return value(c[0]) == l_True && reason(var(c[0])) != CRef_Undef && ca.lea(reason(var(c[0]))) == &c; }
+inline bool     Solver::locked          (const Clause& c) const {
+    // Binary clauses are not reordered by 'propagate()', so either literal may be the implied one:
+    for (int i = 0; i < (c.size() == 2 ? 2 : 1); i++)
+        if (value(c[i]) == l_True && reason(var(c[i])) != CRef_Undef && reason(var(c[i])) != CRef_Lazy && ca.lea(reason(var(c[i]))) == &c)
+            return true;
+    return false; }
 inline void     Solver::newDecisionLevel()                      { trail_lim.push(trail.size()); }
+inline void     Solver::uncheckedEnqueue(Lit p, CRef from)      { uncheckedEnqueue(p, decisionLevel(), from); }
 
 inline int      Solver::decisionLevel ()      const   { return trail_lim.size(); }
 inline uint32_t Solver::abstractLevel (Var x) const   { return 1 << (level(x) & 31); }
@@ -354,10 +509,21 @@ inline lbool    Solver::modelValue    (Lit p) const   { return model[var(p)] ^ s
 inline int      Solver::nAssigns      ()      const   { return trail.size(); }
 inline int      Solver::nClauses      ()      const   { return num_clauses; }
 inline int      Solver::nLearnts      ()      const   { return num_learnts; }
+inline uint64_t Solver::arenaBytes    ()      const   { return (uint64_t)ca.size() * ClauseAllocator::Unit_Size; }
+inline int      Solver::nAtMosts      ()      const   { return card_bound.size(); }
 inline int      Solver::nVars         ()      const   { return next_var; }
 // TODO: nFreeVars() is not quite correct, try to calculate right instead of adapting it like below:
 inline int      Solver::nFreeVars     ()      const   { return (int)dec_vars - (trail_lim.size() == 0 ? trail.size() : trail_lim[0]); }
 inline void     Solver::setPolarity   (Var v, lbool b){ user_pol[v] = b; }
+inline void     Solver::suggestPhase  (Var v, bool b){ polarity[v] = !b; }
+inline void     Solver::bumpActivity  (Var v, double inc){
+    if (branching == branch_vmtf)
+        vmtfEnqueue(v);
+    else if (branching == branch_chb){
+        activity[v] += inc;
+        if (order_heap.inHeap(v)) order_heap.decrease(v); }
+    else
+        varBumpActivity(v, inc); }
 inline void     Solver::setDecisionVar(Var v, bool b) 
 { 
     if      ( b && !decision[v]) dec_vars++;
@@ -370,6 +536,7 @@ inline void     Solver::setConfBudget(int64_t x){ conflict_budget    = conflicts
 inline void     Solver::setPropBudget(int64_t x){ propagation_budget = propagations + x; }
 inline void     Solver::interrupt(){ asynch_interrupt = true; }
 inline void     Solver::clearInterrupt(){ asynch_interrupt = false; }
+inline void     Solver::setExchange(ClauseExchange* x, int worker){ exchange = x; exchange_id = worker; }
 inline void     Solver::budgetOff(){ conflict_budget = propagation_budget = -1; }
 inline bool     Solver::withinBudget() const {
     return !asynch_interrupt &&
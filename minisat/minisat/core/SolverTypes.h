@@ -23,6 +23,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #define Minisat_SolverTypes_h
 
 #include <assert.h>
+#include <string.h>
 
 #include "minisat/mtl/IntTypes.h"
 #include "minisat/mtl/Alg.h"
@@ -135,7 +136,15 @@ inline lbool toLbool(int   v) { return lbool((uint8_t)v);  }
 // Clause -- a simple class for representing a clause:
 
 class Clause;
-typedef RegionAllocator<uint32_t>::Ref CRef;
+
+// Clause references are 32 bits unless the library is built with 'MINISAT_WIDE_REFS', which lifts the
+// 16 GiB limit on the clause database at the price of wider watchers and reasons:
+#ifdef MINISAT_WIDE_REFS
+typedef RegionAllocator<uint32_t, uint64_t> ClauseRegion;
+#else
+typedef RegionAllocator<uint32_t>           ClauseRegion;
+#endif
+typedef ClauseRegion::Ref CRef;
 
 class Clause {
     struct {
@@ -143,8 +152,14 @@ class Clause {
         unsigned learnt    : 1;
         unsigned has_extra : 1;
         unsigned reloced   : 1;
-        unsigned size      : 27; }                        header;
-    union { Lit lit; float act; uint32_t abs; CRef rel; } data[0];
+        unsigned size      : 27;
+        // Learnt clauses only:
+        unsigned lbd       : 28;     // Number of distinct decision levels (glue).
+        unsigned tier      : 2;      // Retention tier (see 'Solver::reduceDB()').
+        unsigned used      : 1;      // Took part in conflict analysis since the last reduction.
+        unsigned vivified  : 1;      // Already vivified (see 'Solver::inprocess()').
+    }                                                    header;
+    union { Lit lit; float act; uint32_t abs; } data[0];
 
     friend class ClauseAllocator;
 
@@ -155,6 +170,10 @@ class Clause {
         header.has_extra = use_extra;
         header.reloced   = 0;
         header.size      = ps.size();
+        header.lbd       = 0;
+        header.tier      = 0;
+        header.used      = 0;
+        header.vivified  = 0;
 
         for (int i = 0; i < ps.size(); i++) 
             data[i].lit = ps[i];
@@ -202,8 +221,8 @@ public:
     const Lit&   last        ()      const   { return data[header.size-1].lit; }
 
     bool         reloced     ()      const   { return header.reloced; }
-    CRef         relocation  ()      const   { return data[0].rel; }
-    void         relocate    (CRef c)        { header.reloced = 1; data[0].rel = c; }
+    CRef         relocation  ()      const   { CRef c; memcpy(&c, data, sizeof(CRef)); return c; }
+    void         relocate    (CRef c)        { header.reloced = 1; memcpy(data, &c, sizeof(CRef)); }
 
     // NOTE: somewhat unsafe to change the clause in-place! Must manually call 'calcAbstraction' afterwards for
     //       subsumption operations to behave correctly.
@@ -214,6 +233,15 @@ public:
     float&       activity    ()              { assert(header.has_extra); return data[header.size].act; }
     uint32_t     abstraction () const        { assert(header.has_extra); return data[header.size].abs; }
 
+    uint32_t     lbd         ()      const   { return header.lbd; }
+    void         lbd         (uint32_t l)    { header.lbd = l; }
+    uint32_t     tier        ()      const   { return header.tier; }
+    void         tier        (uint32_t t)    { header.tier = t; }
+    bool         used        ()      const   { return header.used; }
+    void         used        (bool u)        { header.used = u; }
+    bool         vivified    ()      const   { return header.vivified; }
+    void         vivified    (bool v)        { header.vivified = v; }
+
     Lit          subsumes    (const Clause& other) const;
     void         strengthen  (Lit p);
 };
@@ -222,24 +250,43 @@ public:
 //=================================================================================================
 // ClauseAllocator -- a simple class for allocating memory for clauses:
 
-const CRef CRef_Undef = RegionAllocator<uint32_t>::Ref_Undef;
+const CRef CRef_Undef = ClauseRegion::Ref_Undef;
+const CRef CRef_Lazy  = ClauseRegion::Ref_Undef - 1; // Reason is a cardinality constraint (see 'Solver::reasonClause()').
 class ClauseAllocator
 {
-    RegionAllocator<uint32_t> ra;
+    ClauseRegion ra;
 
+    // NOTE: a relocated clause stores its new reference over its literals, so these must not be
+    // fewer than the words of a 'CRef'.
     static uint32_t clauseWord32Size(int size, bool has_extra){
-        return (sizeof(Clause) + (sizeof(Lit) * (size + (int)has_extra))) / sizeof(uint32_t); }
+        int words = size + (int)has_extra;
+        if (words < (int)(sizeof(CRef) / sizeof(uint32_t)))
+            words = sizeof(CRef) / sizeof(uint32_t);
+        return (sizeof(Clause) + (sizeof(Lit) * words)) / sizeof(uint32_t); }
+
+    // With 'align', no clause starts so close to the end of a cache line that its header and first
+    // two literals (all that 'Solver::propagate()' reads of most clauses) would be split:
+    bool align;
+    CRef allocWords(uint32_t words){
+        enum { line = 64 / sizeof(uint32_t), head = sizeof(Clause) / sizeof(uint32_t) + 2 };
+        if (align){
+            uint32_t offset = ra.size() % line;
+            if (offset + head > line)
+                ra.alloc(line - offset); }
+        return ra.alloc(words); }
 
  public:
-    enum { Unit_Size = RegionAllocator<uint32_t>::Unit_Size };
+    enum { Unit_Size = ClauseRegion::Unit_Size };
 
     bool extra_clause_field;
 
-    ClauseAllocator(uint32_t start_cap) : ra(start_cap), extra_clause_field(false){}
-    ClauseAllocator() : extra_clause_field(false){}
+    ClauseAllocator(CRef start_cap, bool huge_pages = false, bool align_clauses = false) :
+        ra(start_cap, huge_pages), align(align_clauses), extra_clause_field(false){}
+    ClauseAllocator() : align(false), extra_clause_field(false){}
 
     void moveTo(ClauseAllocator& to){
         to.extra_clause_field = extra_clause_field;
+        to.align = align;
         ra.moveTo(to.ra); }
 
     CRef alloc(const vec<Lit>& ps, bool learnt = false)
@@ -247,7 +294,7 @@ class ClauseAllocator
         assert(sizeof(Lit)      == sizeof(uint32_t));
         assert(sizeof(float)    == sizeof(uint32_t));
         bool use_extra = learnt | extra_clause_field;
-        CRef cid       = ra.alloc(clauseWord32Size(ps.size(), use_extra));
+        CRef cid       = allocWords(clauseWord32Size(ps.size(), use_extra));
         new (lea(cid)) Clause(ps, use_extra, learnt);
 
         return cid;
@@ -256,12 +303,25 @@ class ClauseAllocator
     CRef alloc(const Clause& from)
     {
         bool use_extra = from.learnt() | extra_clause_field;
-        CRef cid       = ra.alloc(clauseWord32Size(from.size(), use_extra));
+        CRef cid       = allocWords(clauseWord32Size(from.size(), use_extra));
         new (lea(cid)) Clause(from, use_extra);
         return cid; }
 
-    uint32_t size      () const      { return ra.size(); }
-    uint32_t wasted    () const      { return ra.wasted(); }
+    // Room for a copy of 'from', made later by 'copy()' (possibly on another thread):
+    CRef reserve(const Clause& from)
+    {
+        bool use_extra = from.learnt() | extra_clause_field;
+        return allocWords(clauseWord32Size(from.size(), use_extra)); }
+
+    void copy(CRef cid, const Clause& from)
+    {
+        bool use_extra = from.learnt() | extra_clause_field;
+        new (lea(cid)) Clause(from, use_extra); }
+
+    CRef     size      () const      { return ra.size(); }
+    CRef     wasted    () const      { return ra.wasted(); }
+    bool     hugePages () const      { return ra.hugePages(); }
+    bool     aligned   () const      { return align; }
 
     // Deref, Load Effective Address (LEA), Inverse of LEA (AEL):
     Clause&       operator[](CRef r)         { return (Clause&)ra[r]; }
@@ -78,6 +78,16 @@ static inline void copy(const vec<T>& from, vec<T>& to, bool append = false)
 template<class T>
 static inline void append(const vec<T>& from, vec<T>& to){ copy(from, to, true); }
 
+// Hint the processor to bring 'addr' into the cache (does nothing where this is not supported):
+static inline void prefetch(const void* addr)
+{
+#if defined(__GNUC__)
+    __builtin_prefetch(addr);
+#else
+    (void)addr;
+#endif
+}
+
 //=================================================================================================
 }
 
@@ -21,6 +21,10 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #ifndef Minisat_Alloc_h
 #define Minisat_Alloc_h
 
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
 #include "minisat/mtl/XAlloc.h"
 #include "minisat/mtl/Vec.h"
 
@@ -28,33 +32,42 @@ namespace Minisat {
 
 //=================================================================================================
 // Simple Region-based memory allocator:
+//
+// 'R' is the type of the references, 'uint32_t' limits the region to 2^32 units of 'T', 'uint64_t'
+// lifts that limit at the cost of wider references. On Linux the region is an anonymous mapping that
+// grows with 'mremap()', which moves page tables instead of copying the contents, and can be backed
+// by transparent huge pages to save TLB misses when it is large.
 
-template<class T>
+template<class T, class R = uint32_t>
 class RegionAllocator
 {
     T*        memory;
-    uint32_t  sz;
-    uint32_t  cap;
-    uint32_t  wasted_;
+    R         sz;
+    R         cap;
+    R         wasted_;
+    size_t    mapped;     // Bytes of the mapping holding 'memory' (Linux only).
+    bool      huge;
 
-    void capacity(uint32_t min_cap);
+    void capacity(R min_cap);
+    void release ();
 
  public:
     // TODO: make this a class for better type-checking?
-    typedef uint32_t Ref;
-    enum { Ref_Undef = UINT32_MAX };
+    typedef R Ref;
+    static const Ref Ref_Undef = ~(Ref)0;
     enum { Unit_Size = sizeof(T) };
 
-    explicit RegionAllocator(uint32_t start_cap = 1024*1024) : memory(NULL), sz(0), cap(0), wasted_(0){ capacity(start_cap); }
+    explicit RegionAllocator(R start_cap = 1024*1024, bool huge_pages = false) :
+        memory(NULL), sz(0), cap(0), wasted_(0), mapped(0), huge(huge_pages){ capacity(start_cap); }
     ~RegionAllocator()
     {
-        if (memory != NULL)
-            ::free(memory);
+        release();
     }
 
 
-    uint32_t size      () const      { return sz; }
-    uint32_t wasted    () const      { return wasted_; }
+    R        size      () const      { return sz; }
+    R        wasted    () const      { return wasted_; }
+    bool     hugePages () const      { return huge; }
 
     Ref      alloc     (int size); 
     void     free      (int size)    { wasted_ += size; }
@@ -69,31 +82,37 @@ class RegionAllocator
         return  (Ref)(t - &memory[0]); }
 
     void     moveTo(RegionAllocator& to) {
-        if (to.memory != NULL) ::free(to.memory);
+        to.release();
         to.memory = memory;
         to.sz = sz;
         to.cap = cap;
         to.wasted_ = wasted_;
+        to.mapped = mapped;
+        to.huge = huge;
 
         memory = NULL;
         sz = cap = wasted_ = 0;
+        mapped = 0;
     }
 
 
 };
 
-template<class T>
-void RegionAllocator<T>::capacity(uint32_t min_cap)
+template<class T, class R>
+const R RegionAllocator<T, R>::Ref_Undef;
+
+template<class T, class R>
+void RegionAllocator<T, R>::capacity(R min_cap)
 {
     if (cap >= min_cap) return;
 
-    uint32_t prev_cap = cap;
+    R prev_cap = cap;
     while (cap < min_cap){
         // NOTE: Multiply by a factor (13/8) without causing overflow, then add 2 and make the
         // result even by clearing the least significant bit. The resulting sequence of capacities
         // is carefully chosen to hit a maximum capacity that is close to the '2^32-1' limit when
         // using 'uint32_t' as indices so that as much as possible of this space can be used.
-        uint32_t delta = ((cap >> 1) + (cap >> 3) + 2) & ~1;
+        R delta = ((cap >> 1) + (cap >> 3) + 2) & ~(R)1;
         cap += delta;
 
         if (cap <= prev_cap)
@@ -102,19 +121,49 @@ void RegionAllocator<T>::capacity(uint32_t min_cap)
     // printf(" .. (%p) cap = %u\n", this, cap);
 
     assert(cap > 0);
+    if ((size_t)cap > (size_t)-1 / sizeof(T))
+        throw OutOfMemoryException();
+#if defined(__linux__)
+    size_t page  = 4096;
+    size_t bytes = (sizeof(T)*(size_t)cap + page - 1) & ~(page - 1);
+    void*  mem   = memory == NULL ? mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)
+                                  : mremap(memory, mapped, bytes, MREMAP_MAYMOVE);
+    if (mem == MAP_FAILED)
+        throw OutOfMemoryException();
+#ifdef MADV_HUGEPAGE
+    if (huge)
+        madvise(mem, bytes, MADV_HUGEPAGE);
+#endif
+    memory = (T*)mem;
+    mapped = bytes;
+#else
     memory = (T*)xrealloc(memory, sizeof(T)*cap);
+#endif
+}
+
+
+template<class T, class R>
+void RegionAllocator<T, R>::release()
+{
+    if (memory == NULL) return;
+#if defined(__linux__)
+    munmap(memory, mapped);
+#else
+    ::free(memory);
+#endif
+    memory = NULL;
 }
 
 
-template<class T>
-typename RegionAllocator<T>::Ref
-RegionAllocator<T>::alloc(int size)
+template<class T, class R>
+typename RegionAllocator<T, R>::Ref
+RegionAllocator<T, R>::alloc(int size)
 { 
     // printf("ALLOC called (this = %p, size = %d)\n", this, size); fflush(stdout);
     assert(size > 0);
     capacity(sz + size);
 
-    uint32_t prev_sz = sz;
+    R prev_sz = sz;
     sz += size;
     
     // Handle overflow:
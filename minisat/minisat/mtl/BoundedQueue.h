@@ -0,0 +1,61 @@
+/**********************************************************************************[BoundedQueue.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_BoundedQueue_h
+#define Minisat_BoundedQueue_h
+
+#include "minisat/mtl/Vec.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// A fixed-size window over the most recent values pushed, with their running sum:
+
+template<class T>
+class BoundedQueue {
+    vec<T>   elems;
+    int      first;
+    int      filled;
+    uint64_t sum;
+
+public:
+    BoundedQueue() : first(0), filled(0), sum(0) {}
+
+    void     initSize (int size)   { elems.clear(); elems.growTo(size); clear(); }
+    void     clear    ()           { first = filled = 0; sum = 0; }
+    bool     isFull   () const     { return filled == elems.size(); }
+    int      size     () const     { return filled; }
+    double   avg      () const     { assert(filled > 0); return (double)sum / filled; }
+
+    void push(T x) {
+        if (isFull()){
+            sum -= elems[first];
+            elems[first] = x;
+            if (++first == elems.size()) first = 0;
+        }else{
+            int i = first + filled;
+            if (i >= elems.size()) i -= elems.size();
+            elems[i] = x;
+            filled++; }
+        sum += x; }
+};
+
+
+//=================================================================================================
+}
+
+#endif
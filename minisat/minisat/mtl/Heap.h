@@ -28,18 +28,21 @@ namespace Minisat {
 
 //=================================================================================================
 // A heap implementation with support for decrease/increase key.
+//
+// Every node has 'D' children, stored next to each other. The default is a binary heap; with 4 or
+// 8 children the heap is shallower and 'percolateDown()' compares children within one or two cache
+// lines instead of following a new line on every level.
 
 
-template<class K, class Comp, class MkIndex = MkIndexDefault<K> >
+template<class K, class Comp, class MkIndex = MkIndexDefault<K>, int D = 2>
 class Heap {
     vec<K>                heap;     // Heap of Keys
     IntMap<K,int,MkIndex> indices;  // Each Key's position (index) in the Heap
     Comp                  lt;       // The heap is a minimum-heap with respect to this comparator
 
     // Index "traversal" functions
-    static inline int left  (int i) { return i*2+1; }
-    static inline int right (int i) { return (i+1)*2; }
-    static inline int parent(int i) { return (i-1) >> 1; }
+    static inline int child (int i) { return i*D+1; }     // The first child; the others follow it.
+    static inline int parent(int i) { return (i-1) / D; }
 
 
     void percolateUp(int i)
@@ -61,12 +64,17 @@ class Heap {
     void percolateDown(int i)
     {
         K x = heap[i];
-        while (left(i) < heap.size()){
-            int child = right(i) < heap.size() && lt(heap[right(i)], heap[left(i)]) ? right(i) : left(i);
-            if (!lt(heap[child], x)) break;
-            heap[i]          = heap[child];
+        while (child(i) < heap.size()){
+            int first = child(i);
+            int last  = first + D < heap.size() ? first + D : heap.size();
+            int best  = first;
+            for (int c = first + 1; c < last; c++)
+                if (lt(heap[c], heap[best]))
+                    best = c;
+            if (!lt(heap[best], x)) break;
+            heap[i]          = heap[best];
             indices[heap[i]] = i;
-            i                = child;
+            i                = best;
         }
         heap   [i] = x;
         indices[x] = i;
@@ -115,10 +123,13 @@ class Heap {
         indices[k] = -1;
 
         if (k_pos < heap.size()-1){
-            heap[k_pos]          = heap.last();
-            indices[heap[k_pos]] = k_pos;
+            // The last key may belong above or below the hole:
+            K x          = heap.last();
+            heap[k_pos]  = x;
+            indices[x]   = k_pos;
             heap.pop();
-            percolateDown(k_pos);
+            percolateUp(k_pos);
+            percolateDown(indices[x]);
         }else
             heap.pop();
     }
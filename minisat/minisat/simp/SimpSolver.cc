@@ -18,6 +18,12 @@ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
 OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 **************************************************************************************************/
 
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include "minisat/mtl/Sort.h"
 #include "minisat/simp/SimpSolver.h"
 #include "minisat/utils/System.h"
@@ -36,6 +42,7 @@ static BoolOption   opt_use_elim         (_cat, "elim",         "Perform variabl
 static IntOption    opt_grow             (_cat, "grow",         "Allow a variable elimination step to grow by a number of clauses.", 0);
 static IntOption    opt_clause_lim       (_cat, "cl-lim",       "Variables are not eliminated if it produces a resolvent with a length above this limit. -1 means no limit", 20,   IntRange(-1, INT32_MAX));
 static IntOption    opt_subsumption_lim  (_cat, "sub-lim",      "Do not check if subsumption against a clause larger than this. -1 means no limit.", 1000, IntRange(-1, INT32_MAX));
+static IntOption    opt_elim_threads     (_cat, "elim-threads", "Number of threads checking variable eliminations in parallel (1 = sequential).", 1, IntRange(1, 256));
 static DoubleOption opt_simp_garbage_frac(_cat, "simp-gc-frac", "The fraction of wasted memory allowed before a garbage collection is triggered during simplification.",  0.5, DoubleRange(0, false, HUGE_VAL, false));
 
 
@@ -52,6 +59,7 @@ SimpSolver::SimpSolver() :
   , use_rcheck         (opt_use_rcheck)
   , use_elim           (opt_use_elim)
   , extend_model       (true)
+  , elim_threads       (opt_elim_threads)
   , merges             (0)
   , asymm_lits         (0)
   , eliminated_vars    (0)
@@ -61,6 +69,7 @@ SimpSolver::SimpSolver() :
   , elim_heap          (ElimLt(n_occ))
   , bwdsub_assigns     (0)
   , n_touched          (0)
+  , elim_pool          (NULL)
 {
     vec<Lit> dummy(1,lit_Undef);
     ca.extra_clause_field = true; // NOTE: must happen before allocating the dummy clause below.
@@ -71,6 +80,7 @@ SimpSolver::SimpSolver() :
 
 SimpSolver::~SimpSolver()
 {
+    stopElimPool();
 }
 
 
@@ -145,6 +155,17 @@ lbool SimpSolver::solve_(bool do_simp, bool turn_off_simp)
 
 
 
+bool SimpSolver::addAtMost(const vec<Lit>& ps, int k)
+{
+    // Elimination only sees clauses, so it must leave the variables of the constraint alone:
+    for (int i = 0; i < ps.size(); i++){
+        assert(!isEliminated(var(ps[i])));
+        setFrozen(var(ps[i]), true); }
+
+    return Solver::addAtMost(ps, k);
+}
+
+
 bool SimpSolver::addClause_(vec<Lit>& ps)
 {
 #ifndef NDEBUG
@@ -226,10 +247,10 @@ bool SimpSolver::strengthenClause(CRef cr, Lit l)
 }
 
 
-// Returns FALSE if clause is always satisfied ('out_clause' should not be used).
-bool SimpSolver::merge(const Clause& _ps, const Clause& _qs, Var v, vec<Lit>& out_clause)
+// The resolvent of two clauses on 'v', FALSE if it is a tautology. Only reads the clauses, so that
+// worker threads can call it (see 'SimpSolver::runCheck()').
+static bool resolve(const Clause& _ps, const Clause& _qs, Var v, vec<Lit>& out_clause)
 {
-    merges++;
     out_clause.clear();
 
     bool  ps_smallest = _ps.size() < _qs.size();
@@ -258,11 +279,9 @@ bool SimpSolver::merge(const Clause& _ps, const Clause& _qs, Var v, vec<Lit>& ou
 }
 
 
-// Returns FALSE if clause is always satisfied.
-bool SimpSolver::merge(const Clause& _ps, const Clause& _qs, Var v, int& size)
+// Same as above, but only computes the size of the resolvent.
+static bool resolve(const Clause& _ps, const Clause& _qs, Var v, int& size)
 {
-    merges++;
-
     bool  ps_smallest = _ps.size() < _qs.size();
     const Clause& ps  =  ps_smallest ? _qs : _ps;
     const Clause& qs  =  ps_smallest ? _ps : _qs;
@@ -289,6 +308,22 @@ bool SimpSolver::merge(const Clause& _ps, const Clause& _qs, Var v, int& size)
 }
 
 
+// Returns FALSE if clause is always satisfied ('out_clause' should not be used).
+bool SimpSolver::merge(const Clause& _ps, const Clause& _qs, Var v, vec<Lit>& out_clause)
+{
+    merges++;
+    return resolve(_ps, _qs, v, out_clause);
+}
+
+
+// Returns FALSE if clause is always satisfied.
+bool SimpSolver::merge(const Clause& _ps, const Clause& _qs, Var v, int& size)
+{
+    merges++;
+    return resolve(_ps, _qs, v, size);
+}
+
+
 void SimpSolver::gatherTouchedClauses()
 {
     if (n_touched == 0) return;
@@ -495,17 +530,30 @@ bool SimpSolver::eliminateVar(Var v)
     for (int i = 0; i < cls.size(); i++)
         (find(ca[cls[i]], mkLit(v)) ? pos : neg).push(cls[i]);
 
+    // Use the result of a worker thread if its clauses are still the same:
+    const ElimCheck* chk = NULL;
+    if (elim_threads > 1){
+        if ((chk = validCheck(v, cls)) == NULL)
+            checkEliminations(v);
+        chk = validCheck(v, cls); }
+
     // Check wether the increase in number of clauses stays within the allowed ('grow'). Moreover, no
     // clause must exceed the limit on the maximal clause size (if it is set):
     //
-    int cnt         = 0;
-    int clause_size = 0;
+    if (chk != NULL){
+        merges += chk->merges;
+        if (!chk->elim)
+            return true;
+    }else{
+        int cnt         = 0;
+        int clause_size = 0;
 
-    for (int i = 0; i < pos.size(); i++)
-        for (int j = 0; j < neg.size(); j++)
-            if (merge(ca[pos[i]], ca[neg[j]], v, clause_size) && 
-                (++cnt > cls.size() + grow || (clause_lim != -1 && clause_size > clause_lim)))
-                return true;
+        for (int i = 0; i < pos.size(); i++)
+            for (int j = 0; j < neg.size(); j++)
+                if (merge(ca[pos[i]], ca[neg[j]], v, clause_size) && 
+                    (++cnt > cls.size() + grow || (clause_lim != -1 && clause_size > clause_lim)))
+                    return true;
+    }
 
     // Delete and store old clauses:
     eliminated[v] = true;
@@ -527,10 +575,21 @@ bool SimpSolver::eliminateVar(Var v)
 
     // Produce clauses in cross product:
     vec<Lit>& resolvent = add_tmp;
-    for (int i = 0; i < pos.size(); i++)
-        for (int j = 0; j < neg.size(); j++)
-            if (merge(ca[pos[i]], ca[neg[j]], v, resolvent) && !addClause_(resolvent))
+    if (chk != NULL){
+        merges += pos.size() * neg.size();
+        resolvent.clear();
+        for (int i = 0; i < chk->resolvents.size(); i++)
+            if (chk->resolvents[i] != lit_Undef)
+                resolvent.push(chk->resolvents[i]);
+            else if (!addClause_(resolvent))
                 return false;
+            else
+                resolvent.clear();
+    }else
+        for (int i = 0; i < pos.size(); i++)
+            for (int j = 0; j < neg.size(); j++)
+                if (merge(ca[pos[i]], ca[neg[j]], v, resolvent) && !addClause_(resolvent))
+                    return false;
 
     // Free occurs list for this variable:
     occurs[v].clear(true);
@@ -538,11 +597,193 @@ bool SimpSolver::eliminateVar(Var v)
     // Free watchers lists for this variable, if possible:
     if (watches[ mkLit(v)].size() == 0) watches[ mkLit(v)].clear(true);
     if (watches[~mkLit(v)].size() == 0) watches[~mkLit(v)].clear(true);
+    if (watches_bin[ mkLit(v)].size() == 0) watches_bin[ mkLit(v)].clear(true);
+    if (watches_bin[~mkLit(v)].size() == 0) watches_bin[~mkLit(v)].clear(true);
 
     return backwardSubsumptionCheck();
 }
 
 
+// The worker threads of 'checkEliminations()', waiting between batches:
+//
+struct SimpSolver::ElimPool {
+    SimpSolver&              s;
+    std::vector<std::thread> threads;
+    std::mutex               mtx;
+    std::condition_variable  work, done;
+    uint64_t                 batch;
+    int                      start, running;
+    bool                     stop;
+
+    explicit ElimPool(SimpSolver& _s) : s(_s), batch(0), start(0), running(0), stop(false) {
+        for (int t = 1; t < s.elim_threads; t++)
+            threads.emplace_back(&ElimPool::worker, this, t); }
+
+    ~ElimPool() {
+        { std::lock_guard<std::mutex> lock(mtx); stop = true; }
+        work.notify_all();
+        for (size_t t = 0; t < threads.size(); t++)
+            threads[t].join(); }
+
+    void run(int _start) {
+        { std::lock_guard<std::mutex> lock(mtx); start = _start; running = threads.size(); batch++; }
+        work.notify_all(); }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mtx);
+        done.wait(lock, [this](){ return running == 0; }); }
+
+    void worker(int t) {
+        uint64_t seen = 0;
+        for (;;){
+            int first;
+            {   std::unique_lock<std::mutex> lock(mtx);
+                work.wait(lock, [&](){ return stop || batch != seen; });
+                if (stop) return;
+                seen  = batch;
+                first = start; }
+
+            for (int i = first + t; i < s.elim_checks.size(); i += s.elim_threads)
+                runCheck(s.ca, s.elim_checks[i], s.grow, s.clause_lim);
+
+            std::lock_guard<std::mutex> lock(mtx);
+            if (--running == 0)
+                done.notify_one();
+        }
+    }
+};
+
+
+/*_________________________________________________________________________________________________
+|
+|  checkEliminations : (first : Var)  ->  [void]
+|  
+|  Description:
+|    Runs the check of 'eliminateVar()' for 'first' and the unchecked variables near the top of
+|    'elim_heap' on 'elim_threads' threads, including the resolvents of the variables that can be
+|    eliminated. The candidates are picked so that no two of them share a variable in their clauses;
+|    eliminating one then leaves the clauses of the others alone, unless subsumption reaches them.
+|    Checks are kept until 'eliminateVar()' gets to their variable, in the usual heap order, and only
+|    used if its clauses are unchanged, so the outcome is the same as with sequential elimination.
+|________________________________________________________________________________________________@*/
+void SimpSolver::checkEliminations(Var first)
+{
+    if (elim_checks.size() >= 256 * elim_threads)
+        clearChecks();
+    elim_check_idx.growTo(nVars(), -1);
+    elim_region   .growTo(nVars(), 0);
+
+    vec<Var> region;
+    int      start = elim_checks.size();
+    int      limit = start + 8 * elim_threads;
+    for (int i = -1; i < elim_heap.size() && i < 32 * elim_threads && elim_checks.size() < limit; i++){
+        Var v = i < 0 ? first : elim_heap[i];
+        if ((i >= 0 && elim_check_idx[v] >= 0) || isEliminated(v) || value(v) != l_Undef || frozen[v]) continue;
+
+        const vec<CRef>& cls = occurs.lookup(v);
+        bool             independent = true;
+        for (int j = 0; independent && j < cls.size(); j++){
+            const Clause& c = ca[cls[j]];
+            for (int k = 0; independent && k < c.size(); k++)
+                independent = !elim_region[var(c[k])]; }
+        if (!independent) continue;
+
+        for (int j = 0; j < cls.size(); j++){
+            const Clause& c = ca[cls[j]];
+            for (int k = 0; k < c.size(); k++)
+                if (!elim_region[var(c[k])]){
+                    elim_region[var(c[k])] = 1;
+                    region.push(var(c[k])); } }
+
+        elim_check_idx[v] = elim_checks.size();
+        elim_checks.push();
+        ElimCheck& chk = elim_checks.last();
+        chk.v = v;
+        for (int j = 0; j < cls.size(); j++){
+            chk.occs .push(cls[j]);
+            chk.sizes.push(ca[cls[j]].size()); }
+    }
+
+    for (int i = 0; i < region.size(); i++)
+        elim_region[region[i]] = 0;
+
+    // Worker 't' checks every 'elim_threads'-th candidate starting at 't', worker 0 is this thread:
+    bool parallel = elim_checks.size() - start > 1;
+    if (parallel){
+        if (elim_pool != NULL && elim_pool->threads.size() + 1 != (size_t)elim_threads)
+            stopElimPool();
+        if (elim_pool == NULL)
+            elim_pool = new ElimPool(*this);
+        elim_pool->run(start); }
+    for (int i = start; i < elim_checks.size(); i += parallel ? elim_threads : 1)
+        runCheck(ca, elim_checks[i], grow, clause_lim);
+    if (parallel)
+        elim_pool->wait();
+}
+
+
+void SimpSolver::stopElimPool()
+{
+    delete elim_pool;
+    elim_pool = NULL;
+}
+
+
+void SimpSolver::runCheck(const ClauseAllocator& ca, ElimCheck& chk, int grow, int clause_lim)
+{
+    vec<CRef> pos, neg;
+    for (int i = 0; i < chk.occs.size(); i++)
+        (find(ca[chk.occs[i]], mkLit(chk.v)) ? pos : neg).push(chk.occs[i]);
+
+    // The same test as in 'eliminateVar()', stopping at the same merge:
+    int cnt         = 0;
+    int clause_size = 0;
+    chk.elim   = true;
+    chk.merges = 0;
+    for (int i = 0; i < pos.size(); i++)
+        for (int j = 0; j < neg.size(); j++){
+            chk.merges++;
+            if (resolve(ca[pos[i]], ca[neg[j]], chk.v, clause_size) && 
+                (++cnt > chk.occs.size() + grow || (clause_lim != -1 && clause_size > clause_lim))){
+                chk.elim = false;
+                return; }
+        }
+
+    vec<Lit> resolvent;
+    for (int i = 0; i < pos.size(); i++)
+        for (int j = 0; j < neg.size(); j++)
+            if (resolve(ca[pos[i]], ca[neg[j]], chk.v, resolvent)){
+                for (int k = 0; k < resolvent.size(); k++)
+                    chk.resolvents.push(resolvent[k]);
+                chk.resolvents.push(lit_Undef); }
+}
+
+
+// The check made for 'v' by 'checkEliminations()', provided its clauses 'cls' did not change since:
+//
+const SimpSolver::ElimCheck* SimpSolver::validCheck(Var v, const vec<CRef>& cls) const
+{
+    if (v >= elim_check_idx.size() || elim_check_idx[v] < 0)
+        return NULL;
+
+    const ElimCheck& chk = elim_checks[elim_check_idx[v]];
+    if (chk.occs.size() != cls.size())
+        return NULL;
+    for (int i = 0; i < cls.size(); i++)
+        if (chk.occs[i] != cls[i] || chk.sizes[i] != ca[cls[i]].size())
+            return NULL;
+    return &chk;
+}
+
+
+void SimpSolver::clearChecks()
+{
+    for (int i = 0; i < elim_checks.size(); i++)
+        elim_check_idx[elim_checks[i].v] = -1;
+    elim_checks.clear();
+}
+
+
 bool SimpSolver::substitute(Var v, Lit x)
 {
     assert(!frozen[v]);
@@ -655,6 +896,11 @@ bool SimpSolver::eliminate(bool turn_off_elim)
         n_occ    .clear(true);
         elim_heap.clear(true);
         subsumption_queue.clear(true);
+        clearChecks();
+        elim_checks.clear(true);
+        elim_check_idx.clear(true);
+        elim_region.clear(true);
+        stopElimPool();
 
         use_simplification    = false;
         remove_satisfied      = true;
@@ -685,6 +931,9 @@ void SimpSolver::relocAll(ClauseAllocator& to)
 {
     if (!use_simplification) return;
 
+    // Checks refer to clauses by their old references:
+    clearChecks();
+
     // All occurs lists:
     //
     for (int i = 0; i < nVars(); i++){
@@ -711,15 +960,18 @@ void SimpSolver::relocAll(ClauseAllocator& to)
 
 void SimpSolver::garbageCollect()
 {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
     // Initialize the next region to a size corresponding to the estimated utilization degree. This
     // is not precise but should avoid some unnecessary reallocations for the new region:
-    ClauseAllocator to(ca.size() - ca.wasted()); 
+    ClauseAllocator to(ca.size() - ca.wasted(), ca.hugePages(), ca.aligned()); 
 
     to.extra_clause_field = ca.extra_clause_field; // NOTE: this is important to keep (or lose) the extra fields.
     relocAll(to);
     Solver::relocAll(to);
     if (verbosity >= 2)
-        printf("|  Garbage collection:   %12d bytes => %12d bytes             |\n", 
-               ca.size()*ClauseAllocator::Unit_Size, to.size()*ClauseAllocator::Unit_Size);
+        printf("|  Garbage collection:   %12" PRIu64 " bytes => %12" PRIu64 " bytes             |\n", 
+               (uint64_t)ca.size()*ClauseAllocator::Unit_Size, (uint64_t)to.size()*ClauseAllocator::Unit_Size);
     to.moveTo(ca);
+    recordGC(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
 }
@@ -48,6 +48,7 @@ class SimpSolver : public Solver {
     bool    addClause (Lit p, Lit q, Lit r); // Add a ternary clause to the solver.
     bool    addClause (Lit p, Lit q, Lit r, Lit s); // Add a quaternary clause to the solver. 
     bool    addClause_(      vec<Lit>& ps);
+    bool    addAtMost (const vec<Lit>& ps, int k); // Add a cardinality constraint. Its variables are frozen.
     bool    substitute(Var v, Lit x);  // Replace all occurences of v with x (may cause a contradiction).
 
     // Variable mode:
@@ -97,6 +98,7 @@ class SimpSolver : public Solver {
     bool    use_rcheck;        // Check if a clause is already implied. Prett costly, and subsumes subsumptions :)
     bool    use_elim;          // Perform variable elimination.
     bool    extend_model;      // Flag to indicate whether the user needs to look at the full model.
+    int     elim_threads;      // Number of threads checking eliminations ahead of the sequential order (1 = none).
 
     // Statistics:
     //
@@ -124,6 +126,16 @@ class SimpSolver : public Solver {
         //     return c_x < c_y || c_x == c_y && x < y; }
     };
 
+    // The outcome of 'eliminateVar()' for 'v', computed by a worker thread (see 'checkEliminations()'):
+    struct ElimCheck {
+        Var       v;
+        bool      elim;        // The elimination stays within 'grow' and 'clause_lim'.
+        int       merges;      // Number of 'merge()' calls the sequential check makes.
+        vec<CRef> occs;        // Occurrences of 'v' the check was made on,
+        vec<int>  sizes;       // and their sizes.
+        vec<Lit>  resolvents;  // The non-tautological resolvents, each followed by 'lit_Undef'.
+    };
+
     struct ClauseDeleted {
         const ClauseAllocator& ca;
         explicit ClauseDeleted(const ClauseAllocator& _ca) : ca(_ca) {}
@@ -147,9 +159,15 @@ class SimpSolver : public Solver {
     int                 bwdsub_assigns;
     int                 n_touched;
 
+    vec<ElimCheck>      elim_checks;
+    vec<int>            elim_check_idx;      // Index into 'elim_checks' for each variable, or -1.
+    struct ElimPool;
+    ElimPool*           elim_pool;           // Worker threads of 'checkEliminations()', or NULL.
+
     // Temporaries:
     //
     CRef                bwdsub_tmpunit;
+    vec<char>           elim_region;
 
     // Main internal methods:
     //
@@ -162,6 +180,11 @@ class SimpSolver : public Solver {
     bool          merge                    (const Clause& _ps, const Clause& _qs, Var v, int& size);
     bool          backwardSubsumptionCheck (bool verbose = false);
     bool          eliminateVar             (Var v);
+    void          checkEliminations        (Var first);
+    const ElimCheck* validCheck            (Var v, const vec<CRef>& cls) const;
+    void          clearChecks              ();
+    void          stopElimPool             ();
+    static void   runCheck                 (const ClauseAllocator& ca, ElimCheck& chk, int grow, int clause_lim);
     void          extendModel              ();
 
     void          removeClause             (CRef cr);
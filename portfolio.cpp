@@ -0,0 +1,79 @@
+#include "portfolio.h"
+
+#include <atomic>
+#include <thread>
+
+void diversify(Minisat::Solver &solver, int worker)
+{
+   if (worker > 0){
+      solver.random_seed = 91648253 + 7919 * worker;
+      solver.rnd_init_act = true;
+   }
+}
+
+template<class Solver>
+static void connect(std::vector<std::unique_ptr<Solver>> &solvers, Minisat::ClauseExchange &exchange)
+{
+   if (solvers.size() > 1){
+      for (unsigned i = 0; i < solvers.size(); i++){
+         solvers[i]->setExchange(&exchange, i);
+      }
+   }
+}
+
+void share_clauses(std::vector<std::unique_ptr<Minisat::Solver>> &solvers, Minisat::ClauseExchange &exchange)
+{
+   connect(solvers, exchange);
+}
+
+void share_clauses(std::vector<std::unique_ptr<Minisat::SimpSolver>> &solvers, Minisat::ClauseExchange &exchange)
+{
+   connect(solvers, exchange);
+}
+
+template<class Solver>
+static bool solve_all(std::vector<std::unique_ptr<Solver>> &solvers, int &winner)
+{
+   if (solvers.size() == 1){
+      winner = 0;
+      return solvers[0]->solve();
+   }
+
+   std::atomic<int> first(-1);
+   std::vector<Minisat::lbool> answers(solvers.size(), Minisat::l_Undef);
+   std::vector<std::thread> threads;
+   for (unsigned i = 0; i < solvers.size(); i++){
+      threads.emplace_back([&, i](){
+         Minisat::vec<Minisat::Lit> assumptions;
+         answers[i] = solvers[i]->solveLimited(assumptions);
+         int none = -1;
+         // an interrupted solver answers l_Undef, so only a deciding solver can get here first
+         if (answers[i] != Minisat::l_Undef && first.compare_exchange_strong(none, i)){
+            for (unsigned j = 0; j < solvers.size(); j++){
+               if (j != i){
+                  solvers[j]->interrupt();
+               }
+            }
+         }
+      });
+   }
+   for (auto &thread : threads){
+      thread.join();
+   }
+   for (auto &solver : solvers){
+      solver->clearInterrupt();
+   }
+
+   winner = first;
+   return answers[winner] == Minisat::l_True;
+}
+
+bool solve_portfolio(std::vector<std::unique_ptr<Minisat::Solver>> &solvers, int &winner)
+{
+   return solve_all(solvers, winner);
+}
+
+bool solve_portfolio(std::vector<std::unique_ptr<Minisat::SimpSolver>> &solvers, int &winner)
+{
+   return solve_all(solvers, winner);
+}
@@ -0,0 +1,30 @@
+#ifndef PORTFOLIO_H
+#define PORTFOLIO_H
+
+#include <memory>
+#include <vector>
+
+// defines Solver
+#include "minisat/core/Solver.h"
+// defines SimpSolver
+#include "minisat/simp/SimpSolver.h"
+// defines ClauseExchange
+#include "minisat/core/ClauseExchange.h"
+
+// Gives worker i of a portfolio its own random seed and random initial activities, so that the
+// workers explore different parts of the search space. Worker 0 keeps the default settings. Call it
+// before the first variable is created.
+void diversify(Minisat::Solver &solver, int worker);
+
+// Connects every solver to the exchange, as the worker of the same index. A single solver is left
+// unconnected.
+void share_clauses(std::vector<std::unique_ptr<Minisat::Solver>> &solvers, Minisat::ClauseExchange &exchange);
+void share_clauses(std::vector<std::unique_ptr<Minisat::SimpSolver>> &solvers, Minisat::ClauseExchange &exchange);
+
+// Solves all the solvers (which must hold the same problem) at once, one thread each. The first one
+// to decide interrupts the others. Returns its answer and stores its index in winner, the solver to
+// read the model from. A single solver is solved on the calling thread.
+bool solve_portfolio(std::vector<std::unique_ptr<Minisat::Solver>> &solvers, int &winner);
+bool solve_portfolio(std::vector<std::unique_ptr<Minisat::SimpSolver>> &solvers, int &winner);
+
+#endif
@@ -0,0 +1,65 @@
+#include "stats.h"
+
+#include <cinttypes>
+#include <cstdio>
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+   return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+Solve_Stats solver_snapshot(const Minisat::Solver &solver)
+{
+   Solve_Stats s;
+   s.conflicts = solver.conflicts;
+   s.decisions = solver.decisions;
+   s.propagations = solver.propagations;
+   s.learnts = solver.nLearnts();
+   s.arena_bytes = solver.arenaBytes();
+   s.gc_runs = solver.gc_runs;
+   s.gc_seconds = solver.gc_time;
+   s.gc_max_pause = solver.gc_max_pause;
+   return s;
+}
+
+void Request_Stats::clear()
+{
+   *this = Request_Stats();
+}
+
+void Request_Stats::add_solve(int k, bool sat, double seconds, const Solve_Stats &before, const Minisat::Solver &solver)
+{
+   Solve_Stats s = solver_snapshot(solver);
+   s.k = k;
+   s.sat = sat;
+   s.seconds = seconds;
+   s.conflicts -= before.conflicts;
+   s.decisions -= before.decisions;
+   s.propagations -= before.propagations;
+   s.gc_runs -= before.gc_runs;
+   s.gc_seconds -= before.gc_seconds;
+   solves.push_back(s);
+}
+
+void Request_Stats::write_json(std::ostream &out) const
+{
+   // printf style formatting keeps the output independent of the stream's locale and precision
+   char buffer[512];
+   snprintf(buffer, sizeof(buffer),
+            "{\"vertices\":%d,\"edges\":%d,\"cover\":%d,\"parse\":%.6f,\"dedup\":%.6f,\"bounds\":%.6f,"
+            "\"encode\":%.6f,\"output\":%.6f,\"total\":%.6f,\"solves\":[",
+            vertices, edges, cover, parse_seconds, dedup_seconds, bounds_seconds, encode_seconds, output_seconds,
+            total_seconds);
+   out << buffer;
+   for (unsigned i = 0; i < solves.size(); i++){
+      const Solve_Stats &s = solves[i];
+      snprintf(buffer, sizeof(buffer),
+               "%s{\"k\":%d,\"sat\":%s,\"seconds\":%.6f,\"conflicts\":%" PRIu64 ",\"decisions\":%" PRIu64
+               ",\"propagations\":%" PRIu64 ",\"learnts\":%" PRIu64 ",\"arena_bytes\":%" PRIu64 ",\"gc_runs\":%" PRIu64
+               ",\"gc_seconds\":%.6f,\"gc_max_pause\":%.6f}",
+               i > 0 ? "," : "", s.k, s.sat ? "true" : "false", s.seconds, s.conflicts, s.decisions, s.propagations,
+               s.learnts, s.arena_bytes, s.gc_runs, s.gc_seconds, s.gc_max_pause);
+      out << buffer;
+   }
+   out << "]}\n";
+}
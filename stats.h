@@ -0,0 +1,62 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+// defines Solver
+#include "minisat/core/Solver.h"
+
+// Seconds elapsed since start on the monotonic clock.
+double seconds_since(std::chrono::steady_clock::time_point start);
+
+// One solve call: the k it was asked about, its answer and wall time, and the counters of the solver
+// that answered. Search counters count this call only; learnts, arena_bytes and gc_max_pause are the
+// state of the solver when it returned.
+struct Solve_Stats
+{
+   int k = 0;
+   bool sat = false;
+   double seconds = 0;
+   uint64_t conflicts = 0;
+   uint64_t decisions = 0;
+   uint64_t propagations = 0;
+   uint64_t learnts = 0;
+   uint64_t arena_bytes = 0;
+   uint64_t gc_runs = 0;
+   double gc_seconds = 0;
+   double gc_max_pause = 0;
+};
+
+// Counters of a solver, to be passed to Request_Stats::add_solve() once it has solved.
+Solve_Stats solver_snapshot(const Minisat::Solver &solver);
+
+// Statistics of one vertex cover request (a V command and its E command): the time spent in each
+// phase and one entry per solve call. Only the times depend on the machine; with a single solver
+// everything else is the same on every run.
+class Request_Stats
+{
+public:
+   int vertices = 0;
+   int edges = 0;
+   int cover = -1;                  // size of the cover printed, -1 if none was found
+   double parse_seconds = 0;        // reading the edges of the E command
+   double dedup_seconds = 0;        // dropping repeated edges
+   double bounds_seconds = 0;       // greedy cover and lower bound
+   double encode_seconds = 0;       // building the CNFs (with hints), over all k
+   double output_seconds = 0;       // printing the cover
+   double total_seconds = 0;        // from the end of parsing to the end of the output
+   std::vector<Solve_Stats> solves;
+
+   void clear();
+
+   // Records a solve call of solver, given its counters from before the call.
+   void add_solve(int k, bool sat, double seconds, const Solve_Stats &before, const Minisat::Solver &solver);
+
+   // Writes the statistics as a single line JSON object, keys in a fixed order.
+   void write_json(std::ostream &out) const;
+};
+
+#endif
@@ -3,6 +3,7 @@
  * https://github.com/onqtam/doctest/blob/master/doc/markdown/tutorial.md
  */
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#define DOCTEST_CONFIG_NO_POSIX_SIGNALS
 #include "doctest.h"
 #include <iostream>
 #include <list>
@@ -18,6 +19,13 @@
 // defines Solver
 #include "minisat/core/Solver.h"
 
+#include "encoder.h"
+#include "heuristics.h"
+#include "bounds.h"
+#include "portfolio.h"
+#include "stats.h"
+#include "bench/generators.h"
+
 
 
 class AdjacencyMatrix
@@ -206,8 +214,6 @@ private:
    int n = 0;
    int num_vecs = 2;
    bool found_duplicate_edge = false;
-   bool duplicate_clause_entry_v1 = false;
-   bool duplicate_clause_entry_v2 = false;
 
 
 
@@ -243,6 +249,10 @@ private:
       }
       else
       {
+         auto start = std::chrono::steady_clock::now();
+         stats.clear();
+         stats.vertices = n;
+         std::vector<std::vector<int>> parsed(2);
          std::string edge_set = input.substr(whitespace, input.length()-1);
          char edge_set_rb = '}';
          std::size_t current_pos;
@@ -272,6 +282,18 @@ private:
                flag = 0;
                break;
             }
+            parsed[0].push_back(v1);
+            parsed[1].push_back(v2);
+            edge_set.erase(0,edge_set.find_first_of('>', 0) + 2);
+            flag = 2;
+            current_pos = edge_set.find(edge_set_rb, 0);
+         }
+         stats.parse_seconds = seconds_since(start);
+
+         start = std::chrono::steady_clock::now();
+         for (unsigned e = 0; e < parsed[0].size(); e++){
+            int v1 = parsed[0][e];
+            int v2 = parsed[1][e];
             for (unsigned i = 0; i < edge_vector[0].size(); i++){
                if ((edge_vector[0][i] == v1 && edge_vector[1][i] == v2) || (edge_vector[0][i] == v2 && edge_vector[1][i] == v1)){
                   found_duplicate_edge = true;
@@ -282,192 +304,175 @@ private:
                edge_vector[1].push_back(v2);
             }
             found_duplicate_edge = false;
-            edge_set.erase(0,edge_set.find_first_of('>', 0) + 2);
-            flag = 2;
-            current_pos = edge_set.find(edge_set_rb, 0);
          }
-
+         stats.dedup_seconds = seconds_since(start);
+         stats.edges = edge_vector[0].size();
       }
    }
 
-   void create_cnf(){
+   // Statistics of the SimpSolver runs of the last create_cnf(), summed over its solvers.
+   void record_simp(const Minisat::Solver &solver, int clauses_before)
+   {
+   }
 
-      if (flag == 2){
+   void record_simp(const Minisat::SimpSolver &solver, int clauses_before)
+   {
+      simp_vars += solver.nVars();
+      simp_eliminated += solver.eliminated_vars;
+      simp_clauses_before += clauses_before;
+      simp_clauses_after += solver.nClauses();
+   }
 
+   // A portfolio of 'portfolio' solvers for one problem, sharing their short learnt clauses
+   // through exchange when there is more than one.
+   template<class Solver>
+   void new_portfolio(std::vector<std::unique_ptr<Solver>> &solvers, std::unique_ptr<Minisat::ClauseExchange> &exchange)
+   {
+      solvers.clear();
+      for (int i = 0; i < portfolio; i++){
+         solvers.emplace_back(new Solver());
+         diversify(*solvers.back(), i);
+      }
+      if (portfolio > 1){
+         exchange.reset(new Minisat::ClauseExchange(portfolio, share_buffer, share_size, share_lbd));
+         share_clauses(solvers, *exchange);
+      }
+   }
 
-         std::unique_ptr<Minisat::Solver> solver(new Minisat::Solver());
+   // solve_portfolio(), recording the time and the counters of the solver that answered in stats.
+   template<class Solver>
+   bool timed_solve(std::vector<std::unique_ptr<Solver>> &solvers, int k, int &winner)
+   {
+      std::vector<Solve_Stats> before;
+      for (auto &solver : solvers){
+         before.push_back(solver_snapshot(*solver));
+      }
+      auto start = std::chrono::steady_clock::now();
+      bool res = solve_portfolio(solvers, winner);
+      stats.add_solve(k, res, seconds_since(start), before[winner], *solvers[winner]);
+      return res;
+   }
 
-         Minisat::vec<Minisat::Lit> literal_set;
-         Minisat::vec<Minisat::Lit> clause1;
-         // Minisat::vec<Minisat::Lit> clause2;
-         // Minisat::vec<Minisat::Lit> clause3;
-         Minisat::vec<Minisat::Lit> clause4;
-
-         for (int k = 1; k <= n; k++){
-            // auto start = std::chrono::system_clock::now();
-            literal_set.clear();
-
-            //initialize literal_set
-
-            for (int i = 0; i < n; i++){
-               for (int j = 0; j < k; j++){
-                  Minisat::Lit literal;
-                  literal = Minisat::mkLit(solver->newVar());
-                  literal_set.push(literal);
-               }
+   // SAT search for a cover of size at least lower: a fresh portfolio per k, or with the native
+   // encoding a single portfolio that tightens its bound after every cover found.
+   template<class Solver>
+   bool search_cover(int lower, const std::vector<int> &hint_cover, std::vector<int> &vertex_cover_list)
+   {
+      std::vector<std::unique_ptr<Solver>> solvers;
+      std::unique_ptr<Minisat::ClauseExchange> exchange;
+      Minisat::vec<Minisat::Lit> literal_set;
+      bool found = false;
+      int winner = 0;
+
+      if (encoding == NATIVE_ENCODING){
+         // the bound of a native constraint can be tightened between solves, so a single portfolio
+         // walks k down from an upper bound until no smaller cover exists
+         int k = phase_hint || use_bounds ? hint_cover.size() : n;
+         int clauses_before = 0;
+         auto start = std::chrono::steady_clock::now();
+         new_portfolio(solvers, exchange);
+         for (auto &solver : solvers){
+            encode(*solver, literal_set, encoding, n, k, edge_vector);
+            clauses_before = solver->nClauses();
+
+            if (phase_hint){
+               hint_solver(*solver, literal_set, encoding, n, k, edge_vector, hint_cover);
             }
+         }
+         stats.encode_seconds += seconds_since(start);
 
-            //clause 1
-            // for all i element of [1,k], a clause (x[1,i], x[2,i], ... , x[n,i])
-            // std::cout << "Clause 1 ------------------------------" << std::endl;
-            // std::string should_clause1 = "(";
-            // std::string actual_clause1 = "(";
-            for (int i = 1; i <= k; i ++){
-               clause1.clear();
-               for (int r = 1; r <= n; r++){
-                  clause1.push(literal_set[(r - 1)*k + (i - 1) ]);
-                  // should_clause1 += ", x[" + std::to_string(r) + "," + std::to_string(i) + "]";
-                  // actual_clause1 += ", x[" + std::to_string((r - 1)*k + (i - 1)) +"]";
-                  // std::cout << "n = " << n << ", k = " << k << ", r = " << r << ", i = " << i << std::endl;
-               }
-               // std::cout << "Should add to clause 1 - " << should_clause1 << std::endl;
-               // std::cout << "Adding to clause 1 - " << actual_clause1 << std::endl;
-               solver->addClause(clause1);
+         while (timed_solve(solvers, k, winner)){
+            vertex_cover_list = decode(*solvers[winner], literal_set, encoding, n, k);
+            found = true;
+
+            k = vertex_cover_list.size() - 1;
+            bool tightened = k >= lower;
+            for (unsigned i = 0; i < solvers.size() && tightened; i++){
+               tightened = solvers[i]->setAtMostBound(0, k);
             }
-            //clause 2
-            // For all m element of [1,n], for all p,q element of [1,k] with p < q
-            // a clause (~x[m,p], ~x[m,q])
-            // std::cout << "Clause 2 ------------------------------" << std::endl;
-            for (int q = 1; q <= k; q++){
-               for (int p = 1; p < q; p++){
-                  for (int m = 1; m <= n; m++){
-                     solver->addClause(~literal_set[(m - 1)*k + (p - 1)],~literal_set[(m - 1)*k + (q - 1)]);
-
-                     // std::cout << "n = " << n << ", k = " << k << ", q = " << q << ", p = " << p << ", m = " << m << std::endl;
-                     // std::cout << "Should add clause (~x[" << m << "," << p <<"], ~x[" << m << "," << q << "])" << std::endl;
-                     // std::cout << "Adding clause (~x[" << (m - 1)*k + (p - 1) << "], ~x[" << (m - 1)*k + (q - 1) << "])" << std::endl;
-                     // std::cout << std::endl;
-                  }
-               }
+            if (!tightened){
+               break;
             }
-
-            //clause 3
-            // For all m element of [1,k], for all p,q element of [1,n] with p < q
-            // a clause (~x[p,m], ~x[q,m])
-            // std::cout << "Clause 3 ------------------------------" << std::endl;
-            for (int m = 1; m <= k; m++){
-               for (int q = 1; q <= n; q++){
-                  for (int p = 1; p < q; p++){
-                     solver->addClause(~literal_set[(p - 1)*k + (m - 1)],~literal_set[(q - 1)*k + (m - 1)]);
-                     // std::cout << "n = " << n << ", k = " << k << ", q = " << q << ", p = " << p << ", m = " << m << std::endl;
-                     // std::cout << "Should add clause (~x[" << p << "," << m <<"], ~x[" << q << "," << m << "])" << std::endl;
-                     // std::cout << "Adding clause (~x[" << (p - 1)*k + (m - 1) << "], ~x[" << (q - 1)*k + (m - 1) << "])" << std::endl;
-                     // std::cout << std::endl;
-                  }
+         }
+         record_simp(*solvers[winner], clauses_before);
+      }
+      else{
+         for (int k = std::max(lower, 1); k <= n; k++){
+            auto start = std::chrono::steady_clock::now();
+            new_portfolio(solvers, exchange);
+            int clauses_before = 0;
+            for (auto &solver : solvers){
+               encode(*solver, literal_set, encoding, n, k, edge_vector);
+               clauses_before = solver->nClauses();
+
+               if (phase_hint){
+                  hint_solver(*solver, literal_set, encoding, n, k, edge_vector, hint_cover);
                }
             }
+            stats.encode_seconds += seconds_since(start);
 
+            bool res = timed_solve(solvers, k, winner);
+            record_simp(*solvers[winner], clauses_before);
+            if (res){
+               vertex_cover_list = decode(*solvers[winner], literal_set, encoding, n, k);
+               found = true;
+               break;
+            }
+         }
+      }
+      return found;
+   }
 
+   void create_cnf(){
 
-            //clause 4
-            // For all <i,j> element of Edge Set, a clause (x[i,1], x[i,2], ... , x[i,k], x[j,1], x[j,2], ... , x[j,k])
-            // std::cout << "Clause 4 ------------------------------" << std::endl;
-            for (unsigned i = 0; i < edge_vector[0].size(); i++){
-               clause4.clear();
-               // std::string should_clause = "(";
-               // std::string actual_clause = "(";
-               std::vector <int> clause_entry;
-               for (int c = 1; c <= k; c++){
-                  // std::cout << "n = " << n << ", k = " << k << ", i = " << i << ", c = " << c << ", edge = <" << edge_vector[0][i] << "," << edge_vector[1][i] << ">" << std::endl;
-                  //look for duplicate entries
-                  for (auto entry: clause_entry){
-                     if (entry == edge_vector[0][i]*k + (c - 1)){
-                        duplicate_clause_entry_v1 = true;
-                     }
-                     if (entry == edge_vector[1][i]*k + (c - 1)){
-                        duplicate_clause_entry_v2 = true;
-                     }
-                  }
-                  if (!duplicate_clause_entry_v1){
-                     clause4.push(literal_set[edge_vector[0][i]*k + (c - 1)]);
-                     // std::cout << "Should be adding to clause (x[" << edge_vector[0][i] + 1 << "," << c <<"])" << std::endl;
-                     // std::cout << "Adding to clause (x[" << edge_vector[0][i]*k + (c - 1) << "])" << std::endl;
-                     // should_clause += ", x[" + std::to_string(edge_vector[0][i] + 1) + "," + std::to_string(c) + "]";
-                     // actual_clause += ", x[" + std::to_string( edge_vector[0][i]*k + (c - 1)) + "]";
-                  }
-                  if (!duplicate_clause_entry_v2){
-                     clause4.push(literal_set[edge_vector[1][i]*k + (c - 1)]);
-                     // std::cout << "Should be adding to clause (x[" << edge_vector[1][i] + 1 << "," << c << "])" << std::endl;
-                     // should_clause += ", x[" + std::to_string(edge_vector[1][i] + 1) + "," + std::to_string(c) + "]";
-                     // std::cout << "Adding to clause (x[" << edge_vector[1][i]*k + (c - 1) << "])" << std::endl;
-                     // actual_clause += ", x["  +std::to_string( edge_vector[1][i]*k + (c - 1)) + "]";
-                  }
-                  duplicate_clause_entry_v1 = false;
-                  duplicate_clause_entry_v2 = false;
-
-                  // std::cout << "Should be adding to clause (x[" << edge_vector[0][i] + 1 << "," << c <<"], x[" << edge_vector[1][i] + 1 << "," << c << "])" << std::endl;
-                  // should_clause += ", x[" + std::to_string(edge_vector[0][i] + 1) + "," + std::to_string(c) + "], x[" + std::to_string(edge_vector[1][i] + 1) + "," + std::to_string(c) + "]";
-                  // std::cout << "Adding to clause (x[" << edge_vector[0][i]*k + (c - 1) << "], x[" << edge_vector[1][i]*k + (c - 1) << "])" << std::endl;
-                  // actual_clause += ", x[" + std::to_string( edge_vector[0][i]*k + (c - 1)) + "], x[" +std::to_string( edge_vector[1][i]*k + (c - 1)) + "]";
-                  // std::cout << std::endl;
-               }
+      if (flag == 2){
 
-               // should_clause += ")";
-               // actual_clause += ")";
-               // std::cout<< std::endl;
-               // std::cout << "Clause should be " << should_clause << std::endl;
-               // std::cout << "Adding clause " << actual_clause << std::endl;
+         auto start = std::chrono::steady_clock::now();
 
-               solver->addClause(clause4);
-               // std::cout<< std::endl;
+         // the greedy cover bounds k from above, cover_lower_bound() from below
+         std::vector <int> hint_cover;
+         if (phase_hint || use_bounds){
+            hint_cover = greedy_cover(n, edge_vector);
+         }
+         int lower = use_bounds ? cover_lower_bound(n, edge_vector) : 0;
+         stats.bounds_seconds = seconds_since(start);
 
-            }
+         std::vector <int> vertex_cover_list;
+         bool found = false;
+         simp_vars = simp_eliminated = simp_clauses_before = simp_clauses_after = 0;
 
-            // if (k == 1){
-            //    for (int i = 0; i < edge_vector[0].size(); i++){
-            //       for (int j = 0; j < 2; j++){
-            //          std::cout << edge_vector[j][i] << " ";
-            //       }
-            //       std::cout << std::endl;
-            //    }
-            // }
+         if (use_bounds && (int)hint_cover.size() == lower){
+            // the greedy cover is optimal, no SAT call needed
+            vertex_cover_list = hint_cover;
+            found = true;
+         }
+         else if (use_simp){
+            found = search_cover<Minisat::SimpSolver>(lower, hint_cover, vertex_cover_list);
+         }
+         else{
+            found = search_cover<Minisat::Solver>(lower, hint_cover, vertex_cover_list);
+         }
 
-            bool res = solver->solve();
-            if (res){
-               // std::cout << "Satisfying assignment found for k = " << k << std::endl;
-               std::vector <int> vertex_cover_list;
-
-                  for (int r = 0; r < n; r++) {
-                       for (int c = 0; c < k; c++) {
-                           if (solver->modelValue(literal_set[r*k + c]) == Minisat::l_True) {
-                               vertex_cover_list.push_back(r);
-                           }
-                       }
-                   }
-
-                   std::sort(vertex_cover_list.begin(), vertex_cover_list.end());
-                   for (unsigned x = 0; x < vertex_cover_list.size(); x++){
-                     if (x + 1 != vertex_cover_list.size()){
-                        std::cout << vertex_cover_list[x] << " ";
-                     }
-                     else{
-                        std::cout << vertex_cover_list[x] << std::endl;
-                     }
-
-                   }
+         if (found){
+            auto output_start = std::chrono::steady_clock::now();
+            for (unsigned x = 0; x < vertex_cover_list.size(); x++){
+               if (x + 1 != vertex_cover_list.size()){
+                  std::cout << vertex_cover_list[x] << " ";
+               }
+               else{
+                  std::cout << vertex_cover_list[x] << std::endl;
+               }
 
-               break;
             }
-            // else{
-               // std::cout << "No solution found for k = " << k << std::endl;
-            // }
-            // auto end = std::chrono::system_clock::now();
-            // std::chrono::duration<double> diff = end-start;
-            // std::clog << "Duration = " << diff.count() << " seconds" << std::endl << std::endl;
-            solver.reset (new Minisat::Solver());
+            stats.output_seconds = seconds_since(output_start);
+            stats.cover = vertex_cover_list.size();
+         }
+         stats.total_seconds = seconds_since(start);
+         if (stats_out != nullptr){
+            stats.write_json(*stats_out);
+            stats_out->flush();
          }
 
-         // std::cout << "triple for loop is complete\n";
       }
       else{
          std::cerr << "Error: Not enough information provided for graph input\n";
@@ -510,6 +515,20 @@ private:
 
 public:
    std::vector<std::vector<int>> edge_vector;
+   bool phase_hint = false;
+   bool use_bounds = false;
+   bool use_simp = false;
+   int portfolio = 1;
+   int share_lbd = 2;
+   int share_size = 8;
+   int share_buffer = 1 << 16;
+   Encoding encoding = SLOT_ENCODING;
+   int simp_vars = 0;
+   int simp_eliminated = 0;
+   int simp_clauses_before = 0;
+   int simp_clauses_after = 0;
+   Request_Stats stats;                  // of the last request
+   std::ostream *stats_out = nullptr;    // receives stats as a JSON line after every request
 
 
    void cmd_parser(const std::string &input)
@@ -969,6 +988,832 @@ TEST_CASE("Test 25") {
    CHECK(oss.str() == "0 2 3 4 5 6 8 10\n");
 }
 
+
+// Checks that a printed cover ("0 4 5\n") has the expected size and touches every edge.
+static bool is_cover(const std::string &output, const std::vector<std::vector<int>> &edge_vector, unsigned size)
+{
+   std::istringstream iss(output);
+   std::vector<int> cover;
+   int vertex;
+   while (iss >> vertex){
+      cover.push_back(vertex);
+   }
+   if (cover.size() != size){
+      return false;
+   }
+   for (unsigned i = 0; i < edge_vector[0].size(); i++){
+      if (std::find(cover.begin(), cover.end(), edge_vector[0][i]) == cover.end() &&
+          std::find(cover.begin(), cover.end(), edge_vector[1][i]) == cover.end()){
+         return false;
+      }
+   }
+   return true;
+}
+
+TEST_CASE("Greedy cover") {
+   std::vector<std::vector<int>> edge_vector = {{2,12,7,4,13,8,0,11,6,5,8,4,6,4,11,1,3,1,2,0,7},
+                                                {0,0,9,8,3,11,10,4,2,9,7,1,5,10,3,6,4,11,7,5,4}};
+   std::vector<int> cover = greedy_cover(14, edge_vector);
+   std::ostringstream oss;
+   for (auto v : cover){
+      oss << v << " ";
+   }
+
+   CHECK(is_cover(oss.str(), edge_vector, cover.size()));
+   CHECK(cover.size() >= 7);
+}
+
+TEST_CASE("Phase hint") {
+   std::ostringstream oss;
+   std::streambuf* p_cout_streambuf = std::cout.rdbuf();
+   std::cout.rdbuf(oss.rdbuf());
+   Input_Parser Parser;
+   Parser.edge_vector.push_back(std::vector<int>(0));
+   Parser.edge_vector.push_back(std::vector<int>(0));
+   Parser.phase_hint = true;
+
+   std::string input = "V 14";
+   Parser.cmd_parser(input);
+   input = "E {<2,0>,<12,0>,<7,9>,<4,8>,<13,3>,<8,11>,<0,10>,<11,4>,<6,2>,<5,9>,<8,7>,<4,1>,<6,5>,<4,10>,<11,3>,<1,6>,<3,4>,<1,11>,<2,7>,<0,5>,<7,4>}";
+   Parser.cmd_parser(input);
+   std::cout.rdbuf(p_cout_streambuf);
+
+   CHECK(is_cover(oss.str(), Parser.edge_vector, 7));
+}
+
+TEST_CASE("Vertex encoding") {
+   std::ostringstream oss;
+   std::streambuf* p_cout_streambuf = std::cout.rdbuf();
+   std::cout.rdbuf(oss.rdbuf());
+   Input_Parser Parser;
+   Parser.edge_vector.push_back(std::vector<int>(0));
+   Parser.edge_vector.push_back(std::vector<int>(0));
+   Parser.encoding = VERTEX_ENCODING;
+
+   std::string input = "V 16";
+   Parser.cmd_parser(input);
+   input = "E {<13,10>,<4,5>,<13,8>,<3,12>,<11,5>,<4,9>,<10,8>,<6,8>,<7,0>,<9,3>,<2,12>,<4,1>,<8,0>,<10,1>,<7,3>,<6,14>,<1,5>,<8,12>,<4,0>,<11,4>,<3,11>,<15,8>,<8,14>,<2,10>}";
+   Parser.cmd_parser(input);
+   std::cout.rdbuf(p_cout_streambuf);
+
+   CHECK(is_cover(oss.str(), Parser.edge_vector, 8));
+}
+
+TEST_CASE("Vertex encoding with phase hint") {
+   std::ostringstream oss;
+   std::streambuf* p_cout_streambuf = std::cout.rdbuf();
+   std::cout.rdbuf(oss.rdbuf());
+   Input_Parser Parser;
+   Parser.edge_vector.push_back(std::vector<int>(0));
+   Parser.edge_vector.push_back(std::vector<int>(0));
+   Parser.encoding = VERTEX_ENCODING;
+   Parser.phase_hint = true;
+
+   std::string input = "V 5";
+   Parser.cmd_parser(input);
+   input = "E {<0,3>,<0,4>,<4,1>,<3,2>,<3,1>,<3,4>}";
+   Parser.cmd_parser(input);
+   std::cout.rdbuf(p_cout_streambuf);
+
+   CHECK(oss.str() == "3 4\n");
+}
+
+TEST_CASE("Native cardinality constraint") {
+   Minisat::Solver solver;
+   Minisat::vec<Minisat::Lit> x;
+   for (int i = 0; i < 3; i++){
+      x.push(Minisat::mkLit(solver.newVar()));
+   }
+   // a triangle needs two of its three vertices
+   solver.addClause(x[0], x[1]);
+   solver.addClause(x[1], x[2]);
+   solver.addClause(x[0], x[2]);
+
+   CHECK(solver.addAtMost(x, 2));
+   CHECK(solver.solve());
+   int count = 0;
+   for (int i = 0; i < 3; i++){
+      count += solver.modelValue(x[i]) == Minisat::l_True;
+   }
+   CHECK(count == 2);
+
+   solver.setAtMostBound(0, 1);
+   CHECK(!solver.solve());
+}
+
+TEST_CASE("Region allocator") {
+   // 64-bit references, the contents survive the growth of the region
+   typedef Minisat::RegionAllocator<uint32_t, uint64_t> WideRegion;
+   CHECK(WideRegion::Ref_Undef == ~(uint64_t)0);
+   WideRegion region(16);
+   std::vector<uint64_t> refs;
+   for (uint32_t i = 0; i < 100000; i++){
+      refs.push_back(region.alloc(3));
+      region[refs.back()] = i;
+   }
+   CHECK(region.size() == 300000);
+   bool kept = true;
+   for (uint32_t i = 0; i < refs.size(); i++){
+      kept = kept && region[refs[i]] == i;
+   }
+   CHECK(kept);
+
+   // clauses relocated into a region backed by huge pages
+   Minisat::ClauseAllocator from(1024, true);
+   Minisat::ClauseAllocator to(1024, true);
+   Minisat::vec<Minisat::Lit> lits;
+   lits.push(Minisat::mkLit(0));
+   lits.push(Minisat::mkLit(1, true));
+   Minisat::CRef cr = from.alloc(lits);
+   from.reloc(cr, to);
+   to.moveTo(from);
+   CHECK(from.hugePages());
+   CHECK(from[cr].size() == 2);
+   CHECK(from[cr][1] == Minisat::mkLit(1, true));
+}
+
+TEST_CASE("Garbage collection") {
+   std::vector<std::vector<int>> edge_vector = {{2,12,7,4,13,8,0,11,6,5,8,4,6,4,11,1,3,1,2,0,7},
+                                                {0,0,9,8,3,11,10,4,2,9,7,1,5,10,3,6,4,11,7,5,4}};
+   Minisat::vec<Minisat::Lit> literal_set;
+
+   // collecting after every reduction does not change the search, and every pause is in the histogram
+   Minisat::Solver sequential;
+   sequential.garbage_frac = 0;
+   encode(sequential, literal_set, VERTEX_ENCODING, 14, 6, edge_vector);
+   CHECK(!sequential.solve());
+
+   Minisat::Solver parallel;
+   parallel.garbage_frac = 0;
+   parallel.gc_threads = 4;
+   encode(parallel, literal_set, VERTEX_ENCODING, 14, 6, edge_vector);
+   CHECK(!parallel.solve());
+
+   CHECK(parallel.gc_runs > 0);
+   CHECK(parallel.gc_runs == sequential.gc_runs);
+   CHECK(parallel.conflicts == sequential.conflicts);
+   uint64_t pauses = 0;
+   for (int i = 0; i < Minisat::Solver::gc_buckets; i++){
+      pauses += parallel.gc_pauses[i];
+   }
+   CHECK(pauses == parallel.gc_runs);
+
+   Minisat::Solver sat;
+   sat.garbage_frac = 0;
+   sat.gc_threads = 4;
+   encode(sat, literal_set, VERTEX_ENCODING, 14, 7, edge_vector);
+   CHECK(sat.solve());
+
+   std::vector<int> cover = decode(sat, literal_set, VERTEX_ENCODING, 14, 7);
+   std::ostringstream oss;
+   for (auto v : cover){
+      oss << v << " ";
+   }
+   CHECK(is_cover(oss.str(), edge_vector, 7));
+}
+
+TEST_CASE("Clause alignment and prefetch") {
+   std::vector<std::vector<int>> edge_vector = {{2,12,7,4,13,8,0,11,6,5,8,4,6,4,11,1,3,1,2,0,7},
+                                                {0,0,9,8,3,11,10,4,2,9,7,1,5,10,3,6,4,11,7,5,4}};
+   Minisat::vec<Minisat::Lit> literal_set;
+
+   // the header and the first two literals of an aligned clause never straddle a cache line
+   Minisat::ClauseAllocator aligned(1024, false, true);
+   Minisat::vec<Minisat::Lit> lits;
+   bool within_line = true;
+   for (int size = 1; size < 40; size++){
+      lits.push(Minisat::mkLit(size));
+      Minisat::CRef cr = aligned.alloc(lits, size % 2 == 0);
+      within_line = within_line && cr % 16 + sizeof(Minisat::Clause) / 4 + 2 <= 16;
+   }
+   CHECK(within_line);
+   CHECK(aligned.wasted() == 0);
+
+   // prefetching only hides latency, the search is the same
+   Minisat::Solver plain;
+   encode(plain, literal_set, VERTEX_ENCODING, 14, 6, edge_vector);
+   CHECK(!plain.solve());
+
+   Minisat::Solver prefetching;
+   prefetching.prefetch_dist = 8;
+   encode(prefetching, literal_set, VERTEX_ENCODING, 14, 6, edge_vector);
+   CHECK(!prefetching.solve());
+   CHECK(prefetching.conflicts == plain.conflicts);
+   CHECK(prefetching.propagations == plain.propagations);
+
+   Minisat::Solver sat;
+   sat.prefetch_dist = 8;
+   encode(sat, literal_set, VERTEX_ENCODING, 14, 7, edge_vector);
+   CHECK(sat.solve());
+
+   std::vector<int> cover = decode(sat, literal_set, VERTEX_ENCODING, 14, 7);
+   std::ostringstream oss;
+   for (auto v : cover){
+      oss << v << " ";
+   }
+   CHECK(is_cover(oss.str(), edge_vector, 7));
+}
+
+TEST_CASE("Binary watches") {
+   std::vector<std::vector<int>> edge_vector = {{2,12,7,4,13,8,0,11,6,5,8,4,6,4,11,1,3,1,2,0,7},
+                                                {0,0,9,8,3,11,10,4,2,9,7,1,5,10,3,6,4,11,7,5,4}};
+   Minisat::vec<Minisat::Lit> literal_set;
+
+   // the slot encoding is almost all binary clauses; Test 24 needs 7 vertices
+   Minisat::Solver unsat;
+   unsat.binary_watches = true;
+   encode(unsat, literal_set, SLOT_ENCODING, 14, 6, edge_vector);
+   CHECK(!unsat.solve());
+
+   Minisat::Solver sat;
+   sat.binary_watches = true;
+   encode(sat, literal_set, SLOT_ENCODING, 14, 7, edge_vector);
+   CHECK(sat.solve());
+
+   std::vector<int> cover = decode(sat, literal_set, SLOT_ENCODING, 14, 7);
+   std::ostringstream oss;
+   for (auto v : cover){
+      oss << v << " ";
+   }
+   CHECK(is_cover(oss.str(), edge_vector, 7));
+}
+
+TEST_CASE("LBD tiers") {
+   std::vector<std::vector<int>> edge_vector = {{2,12,7,4,13,8,0,11,6,5,8,4,6,4,11,1,3,1,2,0,7},
+                                                {0,0,9,8,3,11,10,4,2,9,7,1,5,10,3,6,4,11,7,5,4}};
+   Minisat::vec<Minisat::Lit> literal_set;
+
+   // a low learnt clause limit makes the tiered reduction run on Test 24
+   Minisat::Solver unsat;
+   unsat.lbd_tiers = true;
+   unsat.learntsize_factor = 0.01;
+   encode(unsat, literal_set, SLOT_ENCODING, 14, 6, edge_vector);
+   CHECK(!unsat.solve());
+
+   Minisat::Solver sat;
+   sat.lbd_tiers = true;
+   sat.learntsize_factor = 0.01;
+   encode(sat, literal_set, SLOT_ENCODING, 14, 7, edge_vector);
+   CHECK(sat.solve());
+
+   std::vector<int> cover = decode(sat, literal_set, SLOT_ENCODING, 14, 7);
+   std::ostringstream oss;
+   for (auto v : cover){
+      oss << v << " ";
+   }
+   CHECK(is_cover(oss.str(), edge_vector, 7));
+}
+
+TEST_CASE("Dynamic restarts") {
+   std::vector<std::vector<int>> edge_vector = {{2,12,7,4,13,8,0,11,6,5,8,4,6,4,11,1,3,1,2,0,7},
+                                                {0,0,9,8,3,11,10,4,2,9,7,1,5,10,3,6,4,11,7,5,4}};
+   Minisat::vec<Minisat::Lit> literal_set;
+
+   // short windows so that Test 24 restarts (and blocks restarts) on the LBD average
+   Minisat::Solver unsat;
+   unsat.dyn_restart = true;
+   unsat.lbd_window = 5;
+   unsat.trail_window = 20;
+   encode(unsat, literal_set, SLOT_ENCODING, 14, 6, edge_vector);
+   CHECK(!unsat.solve());
+   CHECK(unsat.starts > 1);
+
+   Minisat::Solver sat;
+   sat.dyn_restart = true;
+   sat.lbd_window = 5;
+   sat.trail_window = 20;
+   encode(sat, literal_set, SLOT_ENCODING, 14, 7, edge_vector);
+   CHECK(sat.solve());
+
+   std::vector<int> cover = decode(sat, literal_set, SLOT_ENCODING, 14, 7);
+   std::ostringstream oss;
+   for (auto v : cover){
+      oss << v << " ";
+   }
+   CHECK(is_cover(oss.str(), edge_vector, 7));
+}
+
+TEST_CASE("Inprocessing") {
+   std::vector<std::vector<int>> edge_vector = {{2,12,7,4,13,8,0,11,6,5,8,4,6,4,11,1,3,1,2,0,7},
+                                                {0,0,9,8,3,11,10,4,2,9,7,1,5,10,3,6,4,11,7,5,4}};
+   Minisat::vec<Minisat::Lit> literal_set;
+
+   // a full budget so that learnt clauses of Test 24 get vivified
+   Minisat::Solver unsat;
+   unsat.inprocessing = true;
+   unsat.inprocess_frac = 1;
+   encode(unsat, literal_set, SLOT_ENCODING, 14, 6, edge_vector);
+   CHECK(!unsat.solve());
+   CHECK(unsat.vivified_clauses > 0);
+   CHECK(unsat.subsumed_learnts > 0);
+
+   Minisat::Solver sat;
+   sat.inprocessing = true;
+   sat.inprocess_frac = 1;
+   encode(sat, literal_set, SLOT_ENCODING, 14, 7, edge_vector);
+   CHECK(sat.solve());
+
+   std::vector<int> cover = decode(sat, literal_set, SLOT_ENCODING, 14, 7);
+   std::ostringstream oss;
+   for (auto v : cover){
+      oss << v << " ";
+   }
+   CHECK(is_cover(oss.str(), edge_vector, 7));
+}
+
+TEST_CASE("Native encoding") {
+   std::ostringstream oss;
+   std::streambuf* p_cout_streambuf = std::cout.rdbuf();
+   std::cout.rdbuf(oss.rdbuf());
+   Input_Parser Parser;
+   Parser.edge_vector.push_back(std::vector<int>(0));
+   Parser.edge_vector.push_back(std::vector<int>(0));
+   Parser.encoding = NATIVE_ENCODING;
+
+   std::string input = "V 14";
+   Parser.cmd_parser(input);
+   input = "E {<2,0>,<12,0>,<7,9>,<4,8>,<13,3>,<8,11>,<0,10>,<11,4>,<6,2>,<5,9>,<8,7>,<4,1>,<6,5>,<4,10>,<11,3>,<1,6>,<3,4>,<1,11>,<2,7>,<0,5>,<7,4>}";
+   Parser.cmd_parser(input);
+   std::cout.rdbuf(p_cout_streambuf);
+
+   CHECK(is_cover(oss.str(), Parser.edge_vector, 7));
+}
+
+TEST_CASE("Native encoding with phase hint") {
+   std::ostringstream oss;
+   std::streambuf* p_cout_streambuf = std::cout.rdbuf();
+   std::cout.rdbuf(oss.rdbuf());
+   Input_Parser Parser;
+   Parser.edge_vector.push_back(std::vector<int>(0));
+   Parser.edge_vector.push_back(std::vector<int>(0));
+   Parser.encoding = NATIVE_ENCODING;
+   Parser.phase_hint = true;
+
+   std::string input = "V 16";
+   Parser.cmd_parser(input);
+   input = "E {<13,10>,<4,5>,<13,8>,<3,12>,<11,5>,<4,9>,<10,8>,<6,8>,<7,0>,<9,3>,<2,12>,<4,1>,<8,0>,<10,1>,<7,3>,<6,14>,<1,5>,<8,12>,<4,0>,<11,4>,<3,11>,<15,8>,<8,14>,<2,10>}";
+   Parser.cmd_parser(input);
+   std::cout.rdbuf(p_cout_streambuf);
+
+   CHECK(is_cover(oss.str(), Parser.edge_vector, 8));
+}
+
+TEST_CASE("Lower bounds") {
+   // 5-cycle: a matching has 2 edges, the LP optimum is 2.5 and the minimum cover has 3 vertices
+   std::vector<std::vector<int>> cycle = {{0, 1, 2, 3, 4}, {1, 2, 3, 4, 0}};
+   CHECK(matching_bound(5, cycle) == 2);
+   CHECK(lp_bound(5, cycle) == 3);
+   CHECK(cover_lower_bound(5, cycle) == 3);
+
+   // K4 plus a pendant vertex: one clique of four and a single vertex
+   std::vector<std::vector<int>> clique = {{0, 0, 0, 1, 1, 2, 3}, {1, 2, 3, 2, 3, 3, 4}};
+   CHECK(clique_cover_bound(5, clique) == 3);
+   CHECK(matching_bound(5, clique) == 2);
+   CHECK(cover_lower_bound(5, clique) <= 3);
+}
+
+TEST_CASE("Search between bounds") {
+   std::ostringstream oss;
+   std::streambuf* p_cout_streambuf = std::cout.rdbuf();
+   std::cout.rdbuf(oss.rdbuf());
+   Input_Parser Parser;
+   Parser.edge_vector.push_back(std::vector<int>(0));
+   Parser.edge_vector.push_back(std::vector<int>(0));
+   Parser.use_bounds = true;
+
+   std::string input = "V 14";
+   Parser.cmd_parser(input);
+   input = "E {<2,0>,<12,0>,<7,9>,<4,8>,<13,3>,<8,11>,<0,10>,<11,4>,<6,2>,<5,9>,<8,7>,<4,1>,<6,5>,<4,10>,<11,3>,<1,6>,<3,4>,<1,11>,<2,7>,<0,5>,<7,4>}";
+   Parser.cmd_parser(input);
+   std::cout.rdbuf(p_cout_streambuf);
+
+   CHECK(cover_lower_bound(14, Parser.edge_vector) <= 7);
+   CHECK(is_cover(oss.str(), Parser.edge_vector, 7));
+}
+
+TEST_CASE("Native encoding between bounds") {
+   std::ostringstream oss;
+   std::streambuf* p_cout_streambuf = std::cout.rdbuf();
+   std::cout.rdbuf(oss.rdbuf());
+   Input_Parser Parser;
+   Parser.edge_vector.push_back(std::vector<int>(0));
+   Parser.edge_vector.push_back(std::vector<int>(0));
+   Parser.encoding = NATIVE_ENCODING;
+   Parser.use_bounds = true;
+
+   std::string input = "V 16";
+   Parser.cmd_parser(input);
+   input = "E {<13,10>,<4,5>,<13,8>,<3,12>,<11,5>,<4,9>,<10,8>,<6,8>,<7,0>,<9,3>,<2,12>,<4,1>,<8,0>,<10,1>,<7,3>,<6,14>,<1,5>,<8,12>,<4,0>,<11,4>,<3,11>,<15,8>,<8,14>,<2,10>}";
+   Parser.cmd_parser(input);
+   std::cout.rdbuf(p_cout_streambuf);
+
+   CHECK(cover_lower_bound(16, Parser.edge_vector) <= 8);
+   CHECK(is_cover(oss.str(), Parser.edge_vector, 8));
+}
+
+TEST_CASE("SimpSolver preprocessing") {
+   std::vector<std::vector<int>> edge_vector = {{2,12,7,4,13,8,0,11,6,5,8,4,6,4,11,1,3,1,2,0,7},
+                                                {0,0,9,8,3,11,10,4,2,9,7,1,5,10,3,6,4,11,7,5,4}};
+   Minisat::vec<Minisat::Lit> literal_set;
+
+   // the counter registers are eliminated, the vertex variables are frozen
+   Minisat::SimpSolver unsat;
+   encode(unsat, literal_set, VERTEX_ENCODING, 14, 6, edge_vector);
+   CHECK(!unsat.solve());
+
+   Minisat::SimpSolver sat;
+   encode(sat, literal_set, VERTEX_ENCODING, 14, 7, edge_vector);
+   CHECK(sat.solve());
+   CHECK(sat.eliminated_vars > 0);
+   for (int v = 0; v < 14; v++){
+      CHECK(!sat.isEliminated(Minisat::var(literal_set[v])));
+   }
+
+   std::vector<int> cover = decode(sat, literal_set, VERTEX_ENCODING, 14, 7);
+   std::ostringstream oss;
+   for (auto v : cover){
+      oss << v << " ";
+   }
+   CHECK(is_cover(oss.str(), edge_vector, 7));
+}
+
+TEST_CASE("Parallel elimination") {
+   std::vector<std::vector<int>> edge_vector = {{2,12,7,4,13,8,0,11,6,5,8,4,6,4,11,1,3,1,2,0,7},
+                                                {0,0,9,8,3,11,10,4,2,9,7,1,5,10,3,6,4,11,7,5,4}};
+   Encoding encodings[] = {SLOT_ENCODING, VERTEX_ENCODING};
+   for (auto encoding : encodings){
+      Minisat::vec<Minisat::Lit> literal_set;
+
+      // the checks of the worker threads give the same eliminations as the sequential ones
+      Minisat::SimpSolver sequential;
+      encode(sequential, literal_set, encoding, 14, 7, edge_vector);
+      CHECK(sequential.eliminate());
+
+      Minisat::SimpSolver parallel;
+      parallel.elim_threads = 4;
+      encode(parallel, literal_set, encoding, 14, 7, edge_vector);
+      CHECK(parallel.eliminate());
+
+      CHECK(parallel.eliminated_vars == sequential.eliminated_vars);
+      CHECK(parallel.nClauses() == sequential.nClauses());
+      for (int v = 0; v < sequential.nVars(); v++){
+         CHECK(parallel.isEliminated(v) == sequential.isEliminated(v));
+      }
+
+      CHECK(parallel.solve());
+      std::vector<int> cover = decode(parallel, literal_set, encoding, 14, 7);
+      std::ostringstream oss;
+      for (auto v : cover){
+         oss << v << " ";
+      }
+      CHECK(is_cover(oss.str(), edge_vector, 7));
+   }
+}
+
+TEST_CASE("SimpSolver driver option") {
+   Encoding encodings[] = {SLOT_ENCODING, VERTEX_ENCODING, NATIVE_ENCODING};
+   for (auto encoding : encodings){
+      std::ostringstream oss;
+      std::streambuf* p_cout_streambuf = std::cout.rdbuf();
+      std::cout.rdbuf(oss.rdbuf());
+      Input_Parser Parser;
+      Parser.edge_vector.push_back(std::vector<int>(0));
+      Parser.edge_vector.push_back(std::vector<int>(0));
+      Parser.encoding = encoding;
+      Parser.use_simp = true;
+
+      std::string input = "V 14";
+      Parser.cmd_parser(input);
+      input = "E {<2,0>,<12,0>,<7,9>,<4,8>,<13,3>,<8,11>,<0,10>,<11,4>,<6,2>,<5,9>,<8,7>,<4,1>,<6,5>,<4,10>,<11,3>,<1,6>,<3,4>,<1,11>,<2,7>,<0,5>,<7,4>}";
+      Parser.cmd_parser(input);
+      std::cout.rdbuf(p_cout_streambuf);
+
+      CHECK(is_cover(oss.str(), Parser.edge_vector, 7));
+   }
+}
+
+TEST_CASE("Clause exchange") {
+   Minisat::ClauseExchange exchange(3, 32, 4, 2);
+   Minisat::vec<Minisat::Lit> clause;
+   clause.push(Minisat::mkLit(1));
+   clause.push(Minisat::mkLit(2, true));
+   CHECK(exchange.accepts(2, 2));
+   CHECK(!exchange.accepts(5, 2));
+   CHECK(!exchange.accepts(2, 3));
+
+   // a worker receives the clauses of the others, once, and never its own
+   exchange.push(0, clause, 2);
+   std::vector<std::vector<int>> received;
+   auto collect = [&](const Minisat::vec<Minisat::Lit> &c, uint32_t lbd){
+      received.push_back(std::vector<int>());
+      for (int i = 0; i < c.size(); i++){
+         received.back().push_back(Minisat::toInt(c[i]));
+      }
+   };
+   CHECK(exchange.pull(0, collect) == 0);
+   CHECK(received.empty());
+   CHECK(exchange.pull(1, collect) == 0);
+   CHECK(received.size() == 1);
+   CHECK(received[0] == std::vector<int>({Minisat::toInt(Minisat::mkLit(1)), Minisat::toInt(Minisat::mkLit(2, true))}));
+   CHECK(exchange.pull(1, collect) == 0);
+   CHECK(received.size() == 1);
+
+   // a reader that has been lapped skips to the newest clauses
+   for (int i = 0; i < 20; i++){
+      exchange.push(0, clause, 1);
+   }
+   received.clear();
+   CHECK(exchange.pull(2, collect) == 1);
+   CHECK(received.empty());
+   exchange.push(0, clause, 1);
+   CHECK(exchange.pull(2, collect) == 0);
+   CHECK(received.size() == 1);
+}
+
+TEST_CASE("Portfolio") {
+   std::vector<std::vector<int>> edge_vector = {{2,12,7,4,13,8,0,11,6,5,8,4,6,4,11,1,3,1,2,0,7},
+                                                {0,0,9,8,3,11,10,4,2,9,7,1,5,10,3,6,4,11,7,5,4}};
+   Minisat::vec<Minisat::Lit> literal_set;
+
+   // racing workers agree on the answer, and they share what they learn
+   Minisat::ClauseExchange exchange(3);
+   std::vector<std::unique_ptr<Minisat::Solver>> solvers;
+   for (int i = 0; i < 3; i++){
+      solvers.emplace_back(new Minisat::Solver());
+      diversify(*solvers.back(), i);
+      encode(*solvers.back(), literal_set, VERTEX_ENCODING, 14, 6, edge_vector);
+   }
+   share_clauses(solvers, exchange);
+   int winner = -1;
+   CHECK(!solve_portfolio(solvers, winner));
+   CHECK(winner >= 0);
+   CHECK(winner < 3);
+   uint64_t exported = 0;
+   for (auto &solver : solvers){
+      exported += solver->exported_clauses;
+   }
+   CHECK(exported > 0);
+
+   Encoding encodings[] = {SLOT_ENCODING, VERTEX_ENCODING, NATIVE_ENCODING};
+   for (auto encoding : encodings){
+      for (int simp = 0; simp < 2; simp++){
+         std::ostringstream oss;
+         std::streambuf* p_cout_streambuf = std::cout.rdbuf();
+         std::cout.rdbuf(oss.rdbuf());
+         Input_Parser Parser;
+         Parser.edge_vector.push_back(std::vector<int>(0));
+         Parser.edge_vector.push_back(std::vector<int>(0));
+         Parser.encoding = encoding;
+         Parser.use_simp = simp == 1;
+         Parser.portfolio = 3;
+
+         std::string input = "V 14";
+         Parser.cmd_parser(input);
+         input = "E {<2,0>,<12,0>,<7,9>,<4,8>,<13,3>,<8,11>,<0,10>,<11,4>,<6,2>,<5,9>,<8,7>,<4,1>,<6,5>,<4,10>,<11,3>,<1,6>,<3,4>,<1,11>,<2,7>,<0,5>,<7,4>}";
+         Parser.cmd_parser(input);
+         std::cout.rdbuf(p_cout_streambuf);
+
+         CHECK(is_cover(oss.str(), Parser.edge_vector, 7));
+      }
+   }
+}
+
+TEST_CASE("Decision heuristics") {
+   std::vector<std::vector<int>> edge_vector = {{2,12,7,4,13,8,0,11,6,5,8,4,6,4,11,1,3,1,2,0,7},
+                                                {0,0,9,8,3,11,10,4,2,9,7,1,5,10,3,6,4,11,7,5,4}};
+   int heuristics[] = {Minisat::Solver::branch_vsids, Minisat::Solver::branch_vmtf, Minisat::Solver::branch_chb};
+   Encoding encodings[] = {SLOT_ENCODING, VERTEX_ENCODING, NATIVE_ENCODING};
+   for (auto branching : heuristics){
+      for (auto encoding : encodings){
+         Minisat::vec<Minisat::Lit> literal_set;
+
+         Minisat::Solver unsat;
+         unsat.branching = branching;
+         encode(unsat, literal_set, encoding, 14, 6, edge_vector);
+         CHECK(!unsat.solve());
+
+         Minisat::Solver sat;
+         sat.branching = branching;
+         encode(sat, literal_set, encoding, 14, 7, edge_vector);
+         CHECK(sat.solve());
+
+         std::vector<int> cover = decode(sat, literal_set, encoding, 14, 7);
+         std::ostringstream oss;
+         for (auto v : cover){
+            oss << v << " ";
+         }
+         CHECK(is_cover(oss.str(), edge_vector, 7));
+      }
+
+      // eliminated variables are no longer decisions
+      Minisat::vec<Minisat::Lit> literal_set;
+      Minisat::SimpSolver simp;
+      simp.branching = branching;
+      encode(simp, literal_set, VERTEX_ENCODING, 14, 7, edge_vector);
+      CHECK(simp.solve());
+      std::vector<int> cover = decode(simp, literal_set, VERTEX_ENCODING, 14, 7);
+      std::ostringstream oss;
+      for (auto v : cover){
+         oss << v << " ";
+      }
+      CHECK(is_cover(oss.str(), edge_vector, 7));
+   }
+}
+
+// Keys popped from a heap of 1000 variables after some decrease(), increase() and remove() calls.
+template<int D>
+static std::vector<double> heap_order()
+{
+   struct Key_Lt
+   {
+      const std::vector<double> &key;
+      bool operator()(int x, int y) const
+      {
+         return key[x] < key[y];
+      }
+   };
+   std::vector<double> key;
+   for (int v = 0; v < 1000; v++){
+      key.push_back((v * 7919) % 1009);
+   }
+   Minisat::Heap<int, Key_Lt, Minisat::MkIndexDefault<int>, D> heap(Key_Lt{key});
+   for (unsigned v = 0; v < key.size(); v++){
+      heap.insert(v);
+   }
+   for (unsigned v = 0; v < key.size(); v += 3){
+      key[v] -= 50;
+      heap.decrease(v);
+   }
+   for (unsigned v = 1; v < key.size(); v += 7){
+      key[v] += 50;
+      heap.increase(v);
+   }
+   for (unsigned v = 0; v < key.size(); v += 10){
+      heap.remove(v);
+   }
+   std::vector<double> order;
+   while (!heap.empty()){
+      order.push_back(key[heap.removeMin()]);
+   }
+   return order;
+}
+
+TEST_CASE("Heap arity") {
+   std::vector<double> binary = heap_order<2>();
+   CHECK(binary.size() == 900);
+   CHECK(std::is_sorted(binary.begin(), binary.end()));
+   CHECK(heap_order<4>() == binary);
+   CHECK(heap_order<8>() == binary);
+}
+
+TEST_CASE("Binary strengthening") {
+   std::vector<std::vector<int>> edge_vector = {{2,12,7,4,13,8,0,11,6,5,8,4,6,4,11,1,3,1,2,0,7},
+                                                {0,0,9,8,3,11,10,4,2,9,7,1,5,10,3,6,4,11,7,5,4}};
+   Encoding encodings[] = {SLOT_ENCODING, VERTEX_ENCODING, NATIVE_ENCODING};
+   for (auto encoding : encodings){
+      Minisat::vec<Minisat::Lit> literal_set;
+
+      Minisat::Solver unsat;
+      unsat.bin_min = 1000;
+      encode(unsat, literal_set, encoding, 14, 6, edge_vector);
+      CHECK(!unsat.solve());
+
+      Minisat::Solver sat;
+      sat.bin_min = 1000;
+      encode(sat, literal_set, encoding, 14, 7, edge_vector);
+      CHECK(sat.solve());
+
+      std::vector<int> cover = decode(sat, literal_set, encoding, 14, 7);
+      std::ostringstream oss;
+      for (auto v : cover){
+         oss << v << " ";
+      }
+      CHECK(is_cover(oss.str(), edge_vector, 7));
+   }
+
+   // off by default, and then no literal is ever removed
+   Minisat::vec<Minisat::Lit> literal_set;
+   Minisat::Solver plain;
+   CHECK(plain.bin_min == 0);
+   encode(plain, literal_set, SLOT_ENCODING, 14, 6, edge_vector);
+   CHECK(!plain.solve());
+   CHECK(plain.bin_min_literals == 0);
+}
+
+TEST_CASE("Chronological backtracking") {
+   std::vector<std::vector<int>> edge_vector = {{2,12,7,4,13,8,0,11,6,5,8,4,6,4,11,1,3,1,2,0,7},
+                                                {0,0,9,8,3,11,10,4,2,9,7,1,5,10,3,6,4,11,7,5,4}};
+   Encoding encodings[] = {SLOT_ENCODING, VERTEX_ENCODING, NATIVE_ENCODING};
+   for (auto encoding : encodings){
+      Minisat::vec<Minisat::Lit> literal_set;
+
+      // every conflict undoes a single level, so literals are propagated out of order
+      Minisat::Solver unsat;
+      unsat.chrono = 1;
+      encode(unsat, literal_set, encoding, 14, 6, edge_vector);
+      CHECK(!unsat.solve());
+      CHECK(unsat.chrono_backtracks > 0);
+
+      Minisat::Solver sat;
+      sat.chrono = 1;
+      encode(sat, literal_set, encoding, 14, 7, edge_vector);
+      CHECK(sat.solve());
+
+      std::vector<int> cover = decode(sat, literal_set, encoding, 14, 7);
+      std::ostringstream oss;
+      for (auto v : cover){
+         oss << v << " ";
+      }
+      CHECK(is_cover(oss.str(), edge_vector, 7));
+   }
+}
+
+TEST_CASE("Request statistics") {
+   std::ostringstream json;
+   std::vector<Request_Stats> runs;
+   for (int run = 0; run < 2; run++){
+      std::ostringstream oss;
+      std::streambuf* p_cout_streambuf = std::cout.rdbuf();
+      std::cout.rdbuf(oss.rdbuf());
+      Input_Parser Parser;
+      Parser.edge_vector.push_back(std::vector<int>(0));
+      Parser.edge_vector.push_back(std::vector<int>(0));
+      Parser.stats_out = &json;
+
+      Parser.cmd_parser("V 5");
+      Parser.cmd_parser("E {<0,4>,<4,1>,<0,3>,<3,4>,<3,2>,<1,3>,<4,0>}");
+      std::cout.rdbuf(p_cout_streambuf);
+      CHECK(oss.str() == "3 4\n");
+      runs.push_back(Parser.stats);
+   }
+
+   // the duplicate edge is dropped, then k = 1 fails and k = 2 succeeds
+   const Request_Stats &stats = runs[0];
+   CHECK(stats.vertices == 5);
+   CHECK(stats.edges == 6);
+   CHECK(stats.cover == 2);
+   REQUIRE(stats.solves.size() == 2);
+   CHECK(stats.solves[0].k == 1);
+   CHECK(!stats.solves[0].sat);
+   CHECK(stats.solves[1].k == 2);
+   CHECK(stats.solves[1].sat);
+   CHECK(stats.solves[1].propagations > 0);
+   CHECK(stats.solves[1].arena_bytes > 0);
+   CHECK(stats.parse_seconds >= 0);
+   CHECK(stats.total_seconds >= stats.encode_seconds);
+
+   // everything but the times is the same on every run
+   for (unsigned i = 0; i < stats.solves.size(); i++){
+      CHECK(runs[1].solves[i].conflicts == stats.solves[i].conflicts);
+      CHECK(runs[1].solves[i].decisions == stats.solves[i].decisions);
+      CHECK(runs[1].solves[i].propagations == stats.solves[i].propagations);
+      CHECK(runs[1].solves[i].learnts == stats.solves[i].learnts);
+      CHECK(runs[1].solves[i].arena_bytes == stats.solves[i].arena_bytes);
+   }
+
+   // one JSON line per request
+   std::istringstream lines(json.str());
+   std::string line;
+   int count = 0;
+   while (std::getline(lines, line)){
+      CHECK(line.find("{\"vertices\":5,\"edges\":6,\"cover\":2,\"parse\":") == 0);
+      CHECK(line.find("\"solves\":[{\"k\":1,\"sat\":false,") != std::string::npos);
+      CHECK(line.substr(line.size() - 2) == "]}");
+      count++;
+   }
+   CHECK(count == 2);
+}
+
+TEST_CASE("Benchmark graph generators") {
+   const char *names[] = {"erdos-renyi", "barabasi-albert", "grid", "geometric", "bipartite", "planted"};
+   for (const char *name : names){
+      Bench_Graph g1, g2;
+      REQUIRE(generate(name, 20, 0.3, 7, g1));
+      REQUIRE(generate(name, 20, 0.3, 7, g2));
+      CHECK(g1.edge_vector == g2.edge_vector);
+      CHECK(g1.edge_vector[0].size() > 0);
+
+      // edges are sorted, each once, smaller end first
+      for (unsigned i = 0; i < g1.edge_vector[0].size(); i++){
+         CHECK(g1.edge_vector[0][i] < g1.edge_vector[1][i]);
+         CHECK(g1.edge_vector[1][i] < 20);
+         if (i > 0){
+            CHECK(std::make_pair(g1.edge_vector[0][i - 1], g1.edge_vector[1][i - 1]) <
+                  std::make_pair(g1.edge_vector[0][i], g1.edge_vector[1][i]));
+         }
+      }
+   }
+   Bench_Graph g;
+   CHECK(!generate("complete", 20, 0.3, 7, g));
+
+   // a 3 x 4 grid has 9 horizontal and 8 vertical edges, and no diagonals at density 0
+   CHECK(grid(12, 0, 1).edge_vector[0].size() == 17);
+   CHECK(grid(12, 1, 1).edge_vector[0].size() == 17 + 6);
+   // the planted cover of 10 vertices bounds the minimum cover
+   CHECK(cover_lower_bound(30, planted_cover(30, 0.5, 3).edge_vector) <= 10);
+   CHECK(greedy_cover(30, bipartite(30, 0.5, 3).edge_vector).size() <= 15);
+}
+
 // TEST_CASE("Failing Test Examples") {
 //     CHECK(true == false);
 // }